@@ -786,6 +786,8 @@ struct cmListFileLexer_s
   char* string_buffer;
   char* string_position;
   int string_left;
+  int fast_scan;
+  int fast_scan_disabled;
   yyscan_t scanner;
 };
 
@@ -2587,8 +2589,9 @@ static void cmListFileLexerAppend(cmListFileLexer* lexer, const char* text,
   /* If the appended text will fit in the buffer, do not reallocate.  */
   newSize = lexer->token.length + length + 1;
   if (lexer->token.text && newSize <= lexer->size) {
-    strcpy(lexer->token.text + lexer->token.length, text);
+    memcpy(lexer->token.text + lexer->token.length, text, length);
     lexer->token.length += length;
+    lexer->token.text[lexer->token.length] = 0;
     return;
   }
 
@@ -2665,6 +2668,7 @@ static void cmListFileLexerInit(cmListFileLexer* lexer)
 static void cmListFileLexerDestroy(cmListFileLexer* lexer)
 {
   cmListFileLexerSetToken(lexer, 0, 0);
+  lexer->fast_scan = 0;
   if (lexer->file || lexer->string_buffer) {
     cmListFileLexer_yylex_destroy(lexer->scanner);
     if (lexer->file) {
@@ -2679,6 +2683,327 @@ static void cmListFileLexerDestroy(cmListFileLexer* lexer)
   }
 }
 
+/*--------------------------------------------------------------------------*/
+/* Hand-written scanner for in-memory strings without NUL bytes.  It
+   produces the same tokens as the flex rules above, but skips runs of
+   whitespace, comments and bracket bodies with memchr and classifies
+   characters with a switch instead of walking the DFA byte by byte.  The
+   scanner does not need to keep a start condition between calls: every
+   call consumes a complete token.  */
+
+static int cmListFileLexerFastIsUnquoted(char c)
+{
+  switch (c) {
+    case ' ':
+    case '\t':
+    case '\r':
+    case '\n':
+    case '(':
+    case ')':
+    case '#':
+    case '\\':
+    case '"':
+    case '[':
+    case '=':
+    case '\0':
+      return 0;
+    default:
+      return 1;
+  }
+}
+
+static int cmListFileLexerFastIsIdentifier(char c)
+{
+  return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+    (c >= '0' && c <= '9') || c == '_';
+}
+
+/* Length of {MAKEVAR} at p, or 0.  */
+static size_t cmListFileLexerFastMakeVar(const char* p, const char* e)
+{
+  const char* q;
+  if (e - p < 3 || p[0] != '$' || p[1] != '(') {
+    return 0;
+  }
+  for (q = p + 2; q != e && cmListFileLexerFastIsIdentifier(*q); ++q) {
+  }
+  return (q != e && *q == ')') ? (size_t)(q + 1 - p) : 0;
+}
+
+/* Length of {UNQUOTED} at p, or 0.  */
+static size_t cmListFileLexerFastUnquoted(const char* p, const char* e)
+{
+  if (p == e) {
+    return 0;
+  }
+  if (*p == '\\') {
+    return (e - p > 1 && p[1] != '\n') ? 2 : 0;
+  }
+  return cmListFileLexerFastIsUnquoted(*p) ? 1 : 0;
+}
+
+/* Length of {LEGACY} at p, or 0.  */
+static size_t cmListFileLexerFastLegacy(const char* p, const char* e)
+{
+  const char* q;
+  size_t n;
+  if ((n = cmListFileLexerFastMakeVar(p, e)) ||
+      (n = cmListFileLexerFastUnquoted(p, e))) {
+    return n;
+  }
+  if (p == e || *p != '"') {
+    return 0;
+  }
+  for (q = p + 1; q != e;) {
+    if (*q == '"') {
+      return (size_t)(q + 1 - p);
+    }
+    if ((n = cmListFileLexerFastMakeVar(q, e)) ||
+        (n = cmListFileLexerFastUnquoted(q, e))) {
+      q += n;
+    } else if (*q == ' ' || *q == '\t' || *q == '[' || *q == '=') {
+      ++q;
+    } else {
+      return 0;
+    }
+  }
+  return 0;
+}
+
+/* Length of the longest unquoted argument at p, or 0.  The legacy rule
+   matches a superset of the unquoted rule, so it alone decides the
+   length.  Every alternative starts with a different character, so a
+   greedy scan finds the longest match.  */
+static size_t cmListFileLexerFastArgument(const char* p, const char* e)
+{
+  const char* q = p;
+  size_t n = cmListFileLexerFastMakeVar(q, e);
+  if (!n) {
+    n = cmListFileLexerFastUnquoted(q, e);
+  }
+  if (!n && q != e && *q == '=') {
+    n = 1;
+  }
+  if (!n && q != e && *q == '[') {
+    const char* r = q + 1;
+    while (r != e && *r == '=') {
+      ++r;
+    }
+    n = cmListFileLexerFastLegacy(r, e);
+    if (n) {
+      n += (size_t)(r - q);
+    }
+  }
+  if (!n) {
+    return 0;
+  }
+  q += n;
+  for (;;) {
+    n = cmListFileLexerFastLegacy(q, e);
+    if (!n && q != e && (*q == '[' || *q == '=')) {
+      n = 1;
+    }
+    if (!n) {
+      return (size_t)(q - p);
+    }
+    q += n;
+  }
+}
+
+/* Length of the opening "[=*[" at p, or 0.  */
+static size_t cmListFileLexerFastBracketOpen(const char* p, const char* e)
+{
+  const char* q;
+  if (p == e || *p != '[') {
+    return 0;
+  }
+  for (q = p + 1; q != e && *q == '='; ++q) {
+  }
+  return (q != e && *q == '[') ? (size_t)(q + 1 - p) : 0;
+}
+
+/* Update line and column for the consumed text [p, e).  */
+static void cmListFileLexerFastAdvance(cmListFileLexer* lexer, const char* p,
+                                       const char* e)
+{
+  const char* lineStart = 0;
+  const char* nl;
+  while ((nl = (const char*)memchr(p, '\n', (size_t)(e - p)))) {
+    ++lexer->line;
+    lineStart = nl + 1;
+    p = lineStart;
+  }
+  if (lineStart) {
+    lexer->column = (int)(e - lineStart) + 1;
+  } else {
+    lexer->column += (int)(e - p);
+  }
+  lexer->string_left -= (int)(e - lexer->string_position);
+  lexer->string_position = (char*)e;
+}
+
+static void cmListFileLexerFastSetToken(cmListFileLexer* lexer,
+                                        cmListFileLexer_Type type,
+                                        const char* text, size_t length)
+{
+  lexer->token.type = type;
+  cmListFileLexerSetToken(lexer, "", 0);
+  cmListFileLexerAppend(lexer, text, (int)length);
+}
+
+static void cmListFileLexerFastBracket(cmListFileLexer* lexer, const char* p,
+                                       const char* e)
+{
+  const int comment = *p == '#';
+  const char* open = comment ? p + 1 : p;
+  const size_t length = cmListFileLexerFastBracketOpen(open, e);
+  const char* body = open + length;
+  const char* q;
+  if (body != e && *body == '\n') {
+    ++body;
+  }
+  lexer->comment = comment;
+  lexer->bracket = (int)length - 1;
+
+  /* Look for "]" followed by bracket-1 "=" and another "]".  */
+  for (q = body;
+       (q = (const char*)memchr(q, ']', (size_t)(e - q))) != 0;) {
+    const char* r = q + 1;
+    while (r != e && *r == '=') {
+      ++r;
+    }
+    if (r - q == lexer->bracket && r != e && *r == ']') {
+      cmListFileLexerFastSetToken(lexer,
+                                  comment ? cmListFileLexer_Token_CommentBracket
+                                          : cmListFileLexer_Token_ArgumentBracket,
+                                  body, (size_t)(q - body));
+      cmListFileLexerFastAdvance(lexer, p, r + 1);
+      return;
+    }
+    q = r;
+  }
+
+  cmListFileLexerFastSetToken(lexer, cmListFileLexer_Token_BadBracket, body,
+                              (size_t)(e - body));
+  cmListFileLexerFastAdvance(lexer, p, e);
+}
+
+static void cmListFileLexerFastQuoted(cmListFileLexer* lexer, const char* p,
+                                      const char* e)
+{
+  const char* segment = p + 1;
+  const char* q;
+  lexer->token.type = cmListFileLexer_Token_ArgumentQuoted;
+  cmListFileLexerSetToken(lexer, "", 0);
+  for (q = segment; q != e;) {
+    if (*q == '"') {
+      cmListFileLexerAppend(lexer, segment, (int)(q - segment));
+      cmListFileLexerFastAdvance(lexer, p, q + 1);
+      return;
+    }
+    if (*q == '\\' && e - q > 1) {
+      if (q[1] == '\n') {
+        /* Continuation: text is not part of string */
+        cmListFileLexerAppend(lexer, segment, (int)(q - segment));
+        segment = q + 2;
+      }
+      q += 2;
+    } else {
+      ++q;
+    }
+  }
+  cmListFileLexerAppend(lexer, segment, (int)(e - segment));
+  lexer->token.type = cmListFileLexer_Token_BadString;
+  cmListFileLexerFastAdvance(lexer, p, e);
+}
+
+static int cmListFileLexerFastScan(cmListFileLexer* lexer)
+{
+  const char* e = lexer->string_position + lexer->string_left;
+  const char* p;
+  const char* q;
+  size_t n;
+
+  for (;;) {
+    p = lexer->string_position;
+    if (p == e) {
+      lexer->token.type = cmListFileLexer_Token_None;
+      cmListFileLexerSetToken(lexer, 0, 0);
+      return 0;
+    }
+    switch (*p) {
+      case '\n':
+        cmListFileLexerFastSetToken(lexer, cmListFileLexer_Token_Newline, p,
+                                    1);
+        cmListFileLexerFastAdvance(lexer, p, p + 1);
+        return 1;
+      case ' ':
+      case '\t':
+      case '\r':
+        for (q = p + 1; q != e && (*q == ' ' || *q == '\t' || *q == '\r');
+             ++q) {
+        }
+        cmListFileLexerFastSetToken(lexer, cmListFileLexer_Token_Space, p,
+                                    (size_t)(q - p));
+        cmListFileLexerFastAdvance(lexer, p, q);
+        return 1;
+      case '#':
+        if (cmListFileLexerFastBracketOpen(p + 1, e)) {
+          cmListFileLexerFastBracket(lexer, p, e);
+          return 1;
+        }
+        /* Line comment: skip to the newline, which is the next token.  */
+        q = (const char*)memchr(p, '\n', (size_t)(e - p));
+        cmListFileLexerFastAdvance(lexer, p, q ? q : e);
+        continue;
+      case '(':
+        cmListFileLexerFastSetToken(lexer, cmListFileLexer_Token_ParenLeft, p,
+                                    1);
+        cmListFileLexerFastAdvance(lexer, p, p + 1);
+        return 1;
+      case ')':
+        cmListFileLexerFastSetToken(lexer, cmListFileLexer_Token_ParenRight,
+                                    p, 1);
+        cmListFileLexerFastAdvance(lexer, p, p + 1);
+        return 1;
+      case '"':
+        cmListFileLexerFastQuoted(lexer, p, e);
+        return 1;
+      case '[':
+        if (cmListFileLexerFastBracketOpen(p, e)) {
+          cmListFileLexerFastBracket(lexer, p, e);
+          return 1;
+        }
+        break;
+      default:
+        break;
+    }
+
+    n = cmListFileLexerFastArgument(p, e);
+    if (n) {
+      cmListFileLexer_Type type = cmListFileLexer_Token_ArgumentUnquoted;
+      if ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z') || *p == '_') {
+        for (q = p + 1; q != e && cmListFileLexerFastIsIdentifier(*q); ++q) {
+        }
+        if ((size_t)(q - p) == n) {
+          type = cmListFileLexer_Token_Identifier;
+        }
+      }
+      cmListFileLexerFastSetToken(lexer, type, p, n);
+      cmListFileLexerFastAdvance(lexer, p, p + n);
+    } else if (*p == '[') {
+      cmListFileLexerFastSetToken(lexer, cmListFileLexer_Token_ArgumentUnquoted,
+                                  p, 1);
+      cmListFileLexerFastAdvance(lexer, p, p + 1);
+    } else {
+      cmListFileLexerFastSetToken(lexer, cmListFileLexer_Token_BadCharacter, p,
+                                  1);
+      cmListFileLexerFastAdvance(lexer, p, p + 1);
+    }
+    return 1;
+  }
+}
+
 /*--------------------------------------------------------------------------*/
 cmListFileLexer* cmListFileLexer_New(void)
 {
@@ -2762,18 +3087,27 @@ int cmListFileLexer_SetString(cmListFileLexer* lexer, const char* text, int leng
     lexer->string_buffer = (char *) text;
     lexer->string_position = lexer->string_buffer;
     lexer->string_left = length;
+    lexer->fast_scan = !lexer->fast_scan_disabled &&
+      !memchr(text, 0, (size_t)length);
   }
   cmListFileLexerInit(lexer);
   return result;
 }
 
+/*--------------------------------------------------------------------------*/
+void cmListFileLexer_SetFastScan(cmListFileLexer* lexer, int enabled)
+{
+  lexer->fast_scan_disabled = !enabled;
+}
+
 /*--------------------------------------------------------------------------*/
 cmListFileLexer_Token* cmListFileLexer_Scan(cmListFileLexer* lexer)
 {
   if (!lexer->file && !lexer->string_buffer) {
     return 0;
   }
-  if (cmListFileLexer_yylex(lexer->scanner, lexer)) {
+  if (lexer->fast_scan ? cmListFileLexerFastScan(lexer)
+                       : cmListFileLexer_yylex(lexer->scanner, lexer)) {
     return &lexer->token;
   } else {
     cmListFileLexer_SetFileName(lexer, 0, 0);
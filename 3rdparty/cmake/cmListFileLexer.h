@@ -56,6 +56,10 @@ cmListFileLexer* cmListFileLexer_New(void);
 int cmListFileLexer_SetFileName(cmListFileLexer*, const char*,
                                 cmListFileLexer_BOM* bom);
 int cmListFileLexer_SetString(cmListFileLexer*, const char*, int length);
+/* Strings without NUL bytes are scanned by a hand-written scanner, which
+   produces the same tokens as the flex one.  Passing 0 forces the flex
+   scanner for the following cmListFileLexer_SetString calls.  */
+void cmListFileLexer_SetFastScan(cmListFileLexer*, int enabled);
 cmListFileLexer_Token* cmListFileLexer_Scan(cmListFileLexer*);
 long cmListFileLexer_GetCurrentLine(cmListFileLexer*);
 long cmListFileLexer_GetCurrentColumn(cmListFileLexer*);
@@ -0,0 +1,125 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+// Measures the per-request cost of creating the completion items for the keywords of a CMake
+// tool, once for every word like the completion did before the pools, and from the pools for
+// a few typed prefixes. See benchmark/CMakeLists.txt for how to build it.
+
+#include "../cmakecompletionpool.h"
+#include "../cmaketoolmanager.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <iterator>
+#include <limits>
+
+using namespace CMakeProjectManager;
+using namespace CMakeProjectManager::Internal;
+using namespace TextEditor;
+using namespace Utils;
+
+// Words like the variables of CMake, each documented by a help file
+static QMap<QString, FilePath> createKeywords(const FilePath &helpDir, int count)
+{
+    static const char *const parts[] = {"C", "CXX", "BUILD", "INSTALL", "PREFIX", "FLAGS",
+                                        "SOURCE", "BINARY", "DIR", "PATH", "MODULE", "TYPE"};
+    const int partCount = int(std::size(parts));
+
+    QMap<QString, FilePath> keywords;
+    for (int i = 0; i < count; ++i) {
+        const QString word = QString("CMAKE_%1_%2_%3")
+                                 .arg(parts[i % partCount])
+                                 .arg(parts[(i / partCount) % partCount])
+                                 .arg(i);
+        const FilePath helpFile = helpDir.pathAppended(word + ".rst");
+        helpFile.writeFileContents(QString("%1\n%2\n\nDocumentation of ``%1``.\n")
+                                       .arg(word, QString(word.size(), '-'))
+                                       .toUtf8());
+        keywords.insert(word, helpFile);
+    }
+    return keywords;
+}
+
+// What the completion did for each request before the pools
+static QList<AssistProposalItemInterface *> createAllItems(const QMap<QString, FilePath> &words,
+                                                           const QIcon &icon)
+{
+    QList<AssistProposalItemInterface *> list;
+    for (auto it = words.cbegin(); it != words.cend(); ++it) {
+        MarkDownAssitProposalItem *item = new MarkDownAssitProposalItem();
+        item->setText(it.key());
+        if (!it.value().isEmpty())
+            item->setDetail(CMakeToolManager::toolTipForRstHelpFile(it.value()));
+        item->setIcon(icon);
+        list << item;
+    }
+    return list;
+}
+
+template<typename Function>
+static double bestMicroseconds(int iterations, qsizetype &items, const Function &function)
+{
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < iterations; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        const QList<AssistProposalItemInterface *> list = function();
+        best = qMin(best, timer.nsecsElapsed());
+        items = list.size();
+        qDeleteAll(list);
+    }
+    return best / 1e3;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("completionbenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Benchmarks creating the CMake completion items of a proposal.");
+    parser.addHelpOption();
+    const QCommandLineOption wordsOption("words", "Keywords of the CMake tool.", "n", "3000");
+    parser.addOption(wordsOption);
+    const QCommandLineOption iterationsOption("iterations", "Runs, the best one is reported.",
+                                              "n", "20");
+    parser.addOption(iterationsOption);
+    parser.process(app);
+
+    QTextStream out(stdout);
+
+    QTemporaryDir helpDir;
+    const QMap<QString, FilePath> keywords
+        = createKeywords(FilePath::fromString(helpDir.path()),
+                         qMax(1, parser.value(wordsOption).toInt()));
+    const int iterations = qMax(1, parser.value(iterationsOption).toInt());
+    const QIcon icon;
+
+    // The tooltips are cached by the CMake tool manager, measure the requests after the first
+    qDeleteAll(createAllItems(keywords, icon));
+    CMakeCompletionPool::forWords(keywords);
+
+    qsizetype items = 0;
+    const double allItems = bestMicroseconds(iterations, items, [&] {
+        return createAllItems(keywords, icon);
+    });
+    out << QString("%1 words, all items: %2 us\n").arg(keywords.size()).arg(allItems, 0, 'f', 1);
+
+    for (const QString &prefix : {QString(), QString("CMA"), QString("BUILD"),
+                                  QString("CMAKE_CXX_F"), QString("install_dir")}) {
+        const CMakeCompletionFilter filter(prefix, FuzzyMatcher::CaseSensitivity::CaseInsensitive);
+        const double pooled = bestMicroseconds(iterations, items, [&] {
+            return CMakeCompletionPool::forWords(keywords)->createItems(icon, filter);
+        });
+        out << QString("pool, prefix \"%1\": %2 items, %3 us\n")
+                   .arg(prefix)
+                   .arg(items)
+                   .arg(pooled, 0, 'f', 1);
+    }
+    return 0;
+}
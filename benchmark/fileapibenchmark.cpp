@@ -0,0 +1,334 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+// Measures parsing and extracting synthetic file-api replies of increasing size, outside
+// of the IDE. See benchmark/CMakeLists.txt for how to build it.
+
+#include "fileapireplygenerator.h"
+
+#include "../cmakeparsetimings.h"
+#include "../fileapidataextractor.h"
+#include "../fileapiparser.h"
+
+#include <extensionsystem/pluginmanager.h>
+
+#include <utils/aspects.h>
+#include <utils/qtcsettings.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QPromise>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QThreadPool>
+#include <QTextStream>
+
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace CMakeProjectManager::Internal;
+using namespace Utils;
+
+// --------------------------------------------------------------------
+// Allocation counting:
+// --------------------------------------------------------------------
+
+static std::atomic<quint64> s_allocations{0};
+
+#ifdef __GLIBC__
+// Every heap allocation, the ones of the Qt containers included, goes through these
+const char allocationsColumn[] = "allocations";
+
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *p, std::size_t size);
+
+void *malloc(std::size_t size)
+{
+    ++s_allocations;
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size)
+{
+    ++s_allocations;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, std::size_t size)
+{
+    ++s_allocations;
+    return __libc_realloc(p, size);
+}
+}
+#else
+// Only the calls of operator new can be counted portably. The containers of Qt allocate with
+// malloc() directly, so their allocations are not part of the count.
+const char allocationsColumn[] = "new calls";
+
+void *operator new(std::size_t size)
+{
+    ++s_allocations;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+#endif
+
+// The peak only grows over the lifetime of the process, so each scale runs in its own
+// process
+static qint64 peakResidentKb()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return qint64(counters.PeakWorkingSetSize / 1024);
+    return -1;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+#ifdef Q_OS_MACOS
+    return usage.ru_maxrss / 1024; // bytes
+#else
+    return usage.ru_maxrss; // kilobytes
+#endif
+#endif
+}
+
+// --------------------------------------------------------------------
+// Benchmark:
+// --------------------------------------------------------------------
+
+class Result
+{
+public:
+    qint64 parseNs = std::numeric_limits<qint64>::max();
+    qint64 extractNs = std::numeric_limits<qint64>::max();
+    qint64 projectPartsNs = std::numeric_limits<qint64>::max();
+    quint64 allocations = 0;
+    qsizetype projectParts = 0;
+    QString phases;
+};
+
+static bool runScale(const ReplyGeneratorOptions &options, int iterations, const QString &keepDir,
+                     Result &result, QString *errorMessage)
+{
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        *errorMessage = tempDir.errorString();
+        return false;
+    }
+    const FilePath root = keepDir.isEmpty()
+                              ? FilePath::fromString(tempDir.path())
+                              : FilePath::fromUserInput(keepDir).pathAppended(
+                                    QString("targets-%1").arg(options.targets));
+    const FilePath sourceDir = root / "source";
+    const FilePath buildDir = root / "build";
+
+    if (!FileApiReplyGenerator(options).generate(sourceDir, buildDir, errorMessage))
+        return false;
+
+    const FilePath replyFile = FileApiParser::scanForCMakeReplyFile(buildDir);
+    if (replyFile.isEmpty()) {
+        *errorMessage = QString("No reply file found in %1.").arg(buildDir.toUserOutput());
+        return false;
+    }
+
+    for (int i = 0; i < iterations; ++i) {
+        ParseTimings timings;
+        QPromise<std::shared_ptr<FileApiQtcData>> promise;
+        promise.start();
+
+        const quint64 allocationsBefore = s_allocations;
+        QElapsedTimer timer;
+        timer.start();
+
+        QString error;
+        FileApiData data
+            = FileApiParser::parseData(promise, replyFile, "Debug", {}, {}, &timings, error);
+        const qint64 parseNs = timer.nsecsElapsed();
+        if (!error.isEmpty()) {
+            *errorMessage = error;
+            return false;
+        }
+
+        FileApiQtcData qtcData = extractData(QFuture<void>(promise.future()), data, sourceDir,
+                                             buildDir);
+        const qint64 extractNs = timer.nsecsElapsed() - parseNs;
+        if (!qtcData.errorMessage.isEmpty()) {
+            *errorMessage = qtcData.errorMessage;
+            return false;
+        }
+
+        result.allocations = s_allocations - allocationsBefore;
+        result.parseNs = qMin(result.parseNs, parseNs);
+        result.extractNs = qMin(result.extractNs, extractNs);
+        result.projectPartsNs = qMin(result.projectPartsNs,
+                                     timings.durationNs("generateRawProjectParts"));
+        result.projectParts = qtcData.projectParts.size();
+        result.phases = timings.report();
+    }
+    return true;
+}
+
+static QList<int> parseScales(const QString &value)
+{
+    QList<int> scales;
+    for (const QString &s : value.split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const int scale = s.trimmed().toInt(&ok);
+        if (ok && scale > 0)
+            scales.append(scale);
+    }
+    return scales;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fileapibenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks parsing of synthetic CMake file-api replies.");
+    parser.addHelpOption();
+
+    const ReplyGeneratorOptions defaults;
+    const auto intOption = [&parser](const QString &name, const QString &description, int value) {
+        QCommandLineOption option(name, description, "n", QString::number(value));
+        parser.addOption(option);
+        return option;
+    };
+    const QCommandLineOption targetsOption("targets", "Comma separated list of target counts.",
+                                           "list", "10,100,1000,10000");
+    parser.addOption(targetsOption);
+    const QCommandLineOption sourcesOption
+        = intOption("sources", "Source files per target.", defaults.sourcesPerTarget);
+    const QCommandLineOption groupsOption
+        = intOption("groups", "Compile groups per target.", defaults.compileGroups);
+    const QCommandLineOption includesOption
+        = intOption("includes", "Shared include paths per target.", defaults.includes);
+    const QCommandLineOption definesOption
+        = intOption("defines", "Shared defines per target.", defaults.defines);
+    const QCommandLineOption depthOption
+        = intOption("depth", "Backtrace depth.", defaults.backtraceDepth);
+    const QCommandLineOption iterationsOption
+        = intOption("iterations", "Runs per scale, the best one is reported.", 3);
+    const QCommandLineOption threadsOption = intOption(
+        "threads", "Size of the thread pool, 1 runs the concurrent parts serially.",
+        QThread::idealThreadCount());
+    const QCommandLineOption phasesOption("phases", "Print the timings of the parse phases.");
+    parser.addOption(phasesOption);
+    const QCommandLineOption keepOption("keep", "Write the replies to <dir> and keep them.", "dir");
+    parser.addOption(keepOption);
+    QCommandLineOption singleOption("single", "Run the scales in this process, without a header.");
+    singleOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(singleOption);
+    parser.process(app);
+
+    // The parser reads the CMake specific settings, which expect a settings object.
+    QTemporaryDir settingsDir;
+    auto settings = new QtcSettings(settingsDir.filePath("benchmark.ini"), QSettings::IniFormat);
+    ExtensionSystem::PluginManager pluginManager;
+    ExtensionSystem::PluginManager::setSettings(settings);
+    BaseAspect::setQtcSettings(settings);
+
+    ReplyGeneratorOptions options;
+    options.sourcesPerTarget = parser.value(sourcesOption).toInt();
+    options.compileGroups = parser.value(groupsOption).toInt();
+    options.includes = parser.value(includesOption).toInt();
+    options.defines = parser.value(definesOption).toInt();
+    options.backtraceDepth = parser.value(depthOption).toInt();
+    const int iterations = qMax(1, parser.value(iterationsOption).toInt());
+    QThreadPool::globalInstance()->setMaxThreadCount(qMax(1, parser.value(threadsOption).toInt()));
+
+    QTextStream out(stdout);
+    const QList<int> scales = parseScales(parser.value(targetsOption));
+
+    // Runs each scale in a process of its own, with the same options
+    if (!parser.isSet(singleOption)) {
+        out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+                   .arg("targets", 8)
+                   .arg("parts", 8)
+                   .arg("parse ms", 10)
+                   .arg("extract ms", 11)
+                   .arg("rpp ms", 8)
+                   .arg(allocationsColumn, 12)
+                   .arg("peak RSS kB", 12);
+        out.flush();
+        for (int targets : scales) {
+            QProcess process;
+            process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+            process.start(QCoreApplication::applicationFilePath(),
+                          QCoreApplication::arguments().mid(1)
+                              << "--targets" << QString::number(targets) << "--single");
+            if (!process.waitForFinished(-1) || process.exitStatus() != QProcess::NormalExit
+                || process.exitCode() != 0) {
+                QTextStream(stderr) << "Scale " << targets << " failed.\n";
+                return 1;
+            }
+            out << process.readAllStandardOutput();
+            out.flush();
+        }
+        return 0;
+    }
+
+    for (int targets : scales) {
+        options.targets = targets;
+        Result result;
+        QString errorMessage;
+        if (!runScale(options, iterations, parser.value(keepOption), result, &errorMessage)) {
+            QTextStream(stderr) << "Scale " << targets << " failed: " << errorMessage << '\n';
+            return 1;
+        }
+        out << QString("%1 %2 %3 %4 %5 %6 %7\n")
+                   .arg(targets, 8)
+                   .arg(result.projectParts, 8)
+                   .arg(result.parseNs / 1e6, 10, 'f', 1)
+                   .arg(result.extractNs / 1e6, 11, 'f', 1)
+                   .arg(result.projectPartsNs / 1e6, 8, 'f', 1)
+                   .arg(result.allocations, 12)
+                   .arg(peakResidentKb(), 12);
+        if (parser.isSet(phasesOption))
+            out << result.phases << '\n';
+        out.flush();
+    }
+    return 0;
+}
@@ -0,0 +1,338 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "fileapireplygenerator.h"
+
+#include "../fileapiparser.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace Utils;
+
+namespace CMakeProjectManager::Internal {
+
+// --------------------------------------------------------------------
+// Helper:
+// --------------------------------------------------------------------
+
+static QJsonObject version(int major, int minor)
+{
+    return QJsonObject{{"major", major}, {"minor", minor}};
+}
+
+static QJsonArray indexes(int first, int last)
+{
+    QJsonArray result;
+    for (int i = first; i < last; ++i)
+        result.append(i);
+    return result;
+}
+
+static bool writeJson(const FilePath &file, const QJsonObject &object, QString *errorMessage)
+{
+    const expected_str<qint64> result = file.writeFileContents(
+        QJsonDocument(object).toJson(QJsonDocument::Compact));
+    if (!result) {
+        *errorMessage = result.error();
+        return false;
+    }
+    return true;
+}
+
+static bool writeText(const FilePath &file, const QString &contents, QString *errorMessage)
+{
+    if (!file.parentDir().ensureWritableDir()) {
+        *errorMessage = QString("Cannot create directory %1.").arg(file.parentDir().toUserOutput());
+        return false;
+    }
+    const expected_str<qint64> result = file.writeFileContents(contents.toUtf8());
+    if (!result) {
+        *errorMessage = result.error();
+        return false;
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------
+// FileApiReplyGenerator:
+// --------------------------------------------------------------------
+
+FileApiReplyGenerator::FileApiReplyGenerator(const ReplyGeneratorOptions &options)
+    : m_options(options)
+{}
+
+bool FileApiReplyGenerator::generate(const FilePath &sourceDirectory,
+                                     const FilePath &buildDirectory,
+                                     QString *errorMessage) const
+{
+    const ReplyGeneratorOptions &o = m_options;
+    const FilePath replyDir = FileApiParser::cmakeReplyDirectory(buildDirectory);
+    if (!replyDir.ensureWritableDir()) {
+        *errorMessage = QString("Cannot create directory %1.").arg(replyDir.toUserOutput());
+        return false;
+    }
+
+    const int perDirectory = qMax(1, o.targetsPerDirectory);
+    const int directoryCount = (o.targets + perDirectory - 1) / perDirectory;
+    const int depth = qMax(1, o.backtraceDepth);
+    const auto directoryName = [](int d) { return QString("dir%1").arg(d); };
+    const auto targetName = [](int t) { return QString("target_%1").arg(t); };
+    const auto isExecutable = [&o](int t) {
+        return o.executableEvery > 0 && t % o.executableEvery == o.executableEvery - 1;
+    };
+
+    // CMakeLists.txt files:
+    QString topLevel = "cmake_minimum_required(VERSION 3.16)\nproject(Synthetic CXX)\n\n";
+    for (int d = 1; d <= directoryCount; ++d)
+        topLevel += QString("add_subdirectory(%1)\n").arg(directoryName(d));
+    if (!writeText(sourceDirectory / "CMakeLists.txt", topLevel, errorMessage))
+        return false;
+
+    for (int d = 1; d <= directoryCount; ++d) {
+        QString contents;
+        for (int t = (d - 1) * perDirectory; t < qMin(o.targets, d * perDirectory); ++t) {
+            QStringList sources;
+            for (int s = 0; s < o.sourcesPerTarget; ++s)
+                sources << QString("%1/source_%2.cpp").arg(targetName(t)).arg(s);
+            contents += QString("%1(%2%3\n    %4)\n")
+                            .arg(isExecutable(t) ? "add_executable" : "add_library",
+                                 targetName(t),
+                                 isExecutable(t) ? "" : " STATIC",
+                                 sources.join("\n    "));
+            contents += QString("target_include_directories(%1 PRIVATE %1/include)\n"
+                                "target_compile_definitions(%1 PRIVATE %2_LIBRARY)\n\n")
+                            .arg(targetName(t), targetName(t).toUpper());
+        }
+        if (!writeText(sourceDirectory / directoryName(d) / "CMakeLists.txt", contents, errorMessage))
+            return false;
+    }
+
+    // Target files:
+    QJsonArray targets;
+    for (int t = 0; t < o.targets; ++t) {
+        const int d = t / perDirectory + 1;
+        const QString name = targetName(t);
+        const QString id = name + "::@synthetic";
+        const QString jsonFile = QString("target-%1-Debug-%2.json").arg(name).arg(t, 8, 16, QChar('0'));
+        const QString dir = directoryName(d);
+        targets.append(QJsonObject{{"name", name},
+                                   {"id", id},
+                                   {"directoryIndex", d},
+                                   {"projectIndex", 0},
+                                   {"jsonFile", jsonFile}});
+
+        // Backtrace graph: A chain of helper calls, followed by the target commands.
+        QJsonArray nodes;
+        nodes.append(QJsonObject{{"file", 0}});
+        for (int i = 1; i < depth; ++i) {
+            nodes.append(QJsonObject{{"file", 1 + i % 2},
+                                     {"line", 10 + i},
+                                     {"command", 3},
+                                     {"parent", i - 1}});
+        }
+        const int targetNode = nodes.size();
+        nodes.append(QJsonObject{{"file", 0}, {"line", 1 + t % perDirectory}, {"command", 0}, {"parent", depth - 1}});
+        const int includeNode = nodes.size();
+        nodes.append(QJsonObject{{"file", 0}, {"line", 2 + t % perDirectory}, {"command", 1}, {"parent", depth - 1}});
+        const int defineNode = nodes.size();
+        nodes.append(QJsonObject{{"file", 0}, {"line", 3 + t % perDirectory}, {"command", 2}, {"parent", depth - 1}});
+
+        QJsonArray sources;
+        QJsonArray sourceIndexes;
+        QJsonArray headerIndexes;
+        QList<QJsonArray> groupSources(qMax(1, o.compileGroups));
+        for (int s = 0; s < o.sourcesPerTarget; ++s) {
+            const int group = s % groupSources.size();
+            groupSources[group].append(sources.size());
+            sourceIndexes.append(sources.size());
+            sources.append(QJsonObject{{"path", QString("%1/%2/source_%3.cpp").arg(dir, name).arg(s)},
+                                       {"compileGroupIndex", group},
+                                       {"sourceGroupIndex", 0},
+                                       {"backtrace", targetNode}});
+        }
+        for (int s = 0; s < o.sourcesPerTarget / 2; ++s) {
+            headerIndexes.append(sources.size());
+            sources.append(QJsonObject{{"path", QString("%1/%2/header_%3.h").arg(dir, name).arg(s)},
+                                       {"sourceGroupIndex", 1},
+                                       {"backtrace", targetNode}});
+        }
+
+        QJsonArray includes;
+        for (int i = 0; i < o.includes; ++i) {
+            QJsonObject include{{"path", QString("/opt/synthetic/include/module_%1").arg(i)},
+                                {"backtrace", includeNode}};
+            if (i % 5 == 4)
+                include.insert("isSystem", true);
+            includes.append(include);
+        }
+        includes.append(QJsonObject{
+            {"path", sourceDirectory.pathAppended(QString("%1/%2/include").arg(dir, name)).path()},
+            {"backtrace", includeNode}});
+
+        QJsonArray defines;
+        for (int i = 0; i < o.defines; ++i) {
+            defines.append(QJsonObject{{"define", QString("SYNTHETIC_FEATURE_%1=1").arg(i)},
+                                       {"backtrace", defineNode}});
+        }
+        defines.append(QJsonObject{{"define", name.toUpper() + "_LIBRARY"},
+                                   {"backtrace", defineNode}});
+
+        QJsonArray compileGroups;
+        for (const QJsonArray &groupIndexes : std::as_const(groupSources)) {
+            compileGroups.append(QJsonObject{
+                {"language", "CXX"},
+                {"sourceIndexes", groupIndexes},
+                {"compileCommandFragments",
+                 QJsonArray{QJsonObject{{"fragment", "-g -fPIC"}},
+                            QJsonObject{{"fragment", "-std=gnu++17"}}}},
+                {"includes", includes},
+                {"defines", defines}});
+        }
+
+        QJsonObject target{
+            {"name", name},
+            {"id", id},
+            {"type", isExecutable(t) ? "EXECUTABLE" : "STATIC_LIBRARY"},
+            {"backtrace", targetNode},
+            {"paths", QJsonObject{{"source", dir}, {"build", dir}}},
+            {"nameOnDisk", isExecutable(t) ? name : "lib" + name + ".a"},
+            {"artifacts",
+             QJsonArray{QJsonObject{{"path", dir + '/' + (isExecutable(t) ? name : "lib" + name + ".a")}}}},
+            {"sources", sources},
+            {"sourceGroups",
+             QJsonArray{QJsonObject{{"name", "Source Files"}, {"sourceIndexes", sourceIndexes}},
+                        QJsonObject{{"name", "Header Files"}, {"sourceIndexes", headerIndexes}}}},
+            {"compileGroups", compileGroups},
+            {"backtraceGraph",
+             QJsonObject{{"commands",
+                          QJsonArray{isExecutable(t) ? "add_executable" : "add_library",
+                                     "target_include_directories",
+                                     "target_compile_definitions",
+                                     "synthetic_helper"}},
+                         {"files",
+                          QJsonArray{dir + "/CMakeLists.txt",
+                                     "CMakeLists.txt",
+                                     "cmake/SyntheticHelpers.cmake"}},
+                         {"nodes", nodes}}}};
+        if (isExecutable(t)) {
+            QJsonArray fragments{QJsonObject{{"fragment", "-g"}, {"role", "flags"}}};
+            QJsonArray dependencies;
+            for (int l = qMax(0, t - 3); l < t; ++l) {
+                const QString library = QString("%1/lib%2.a").arg(directoryName(l / perDirectory + 1),
+                                                                 targetName(l));
+                fragments.append(QJsonObject{{"fragment", library}, {"role", "libraries"}});
+                dependencies.append(QJsonObject{{"id", targetName(l) + "::@synthetic"},
+                                                {"backtrace", targetNode}});
+            }
+            target.insert("link", QJsonObject{{"language", "CXX"}, {"commandFragments", fragments}});
+            target.insert("dependencies", dependencies);
+        } else {
+            target.insert("archive", QJsonObject{});
+        }
+
+        if (!writeJson(replyDir / jsonFile, target, errorMessage))
+            return false;
+    }
+
+    // Codemodel:
+    QJsonArray directories;
+    directories.append(QJsonObject{{"source", "."},
+                                   {"build", "."},
+                                   {"projectIndex", 0},
+                                   {"childIndexes", indexes(1, directoryCount + 1)}});
+    for (int d = 1; d <= directoryCount; ++d) {
+        directories.append(QJsonObject{{"source", directoryName(d)},
+                                       {"build", directoryName(d)},
+                                       {"parentIndex", 0},
+                                       {"projectIndex", 0},
+                                       {"targetIndexes",
+                                        indexes((d - 1) * perDirectory,
+                                                qMin(o.targets, d * perDirectory))}});
+    }
+    const QJsonObject paths{{"source", sourceDirectory.path()}, {"build", buildDirectory.path()}};
+    const QJsonObject codemodel{
+        {"kind", "codemodel"},
+        {"version", version(2, 6)},
+        {"paths", paths},
+        {"configurations",
+         QJsonArray{QJsonObject{{"name", "Debug"},
+                                {"directories", directories},
+                                {"projects",
+                                 QJsonArray{QJsonObject{{"name", "Synthetic"},
+                                                        {"directoryIndexes",
+                                                         indexes(0, directoryCount + 1)},
+                                                        {"targetIndexes", indexes(0, o.targets)}}}},
+                                {"targets", targets}}}}};
+    if (!writeJson(replyDir / "codemodel-v2-synthetic.json", codemodel, errorMessage))
+        return false;
+
+    // Cache:
+    QJsonArray entries;
+    const auto addEntry = [&entries](const QString &name, const QString &value, bool advanced) {
+        QJsonArray properties{QJsonObject{{"name", "HELPSTRING"},
+                                          {"value", "Synthetic cache entry " + name}}};
+        if (advanced)
+            properties.append(QJsonObject{{"name", "ADVANCED"}, {"value", "1"}});
+        entries.append(QJsonObject{{"name", name},
+                                   {"value", value},
+                                   {"type", "STRING"},
+                                   {"properties", properties}});
+    };
+    addEntry("CMAKE_BUILD_TYPE", "Debug", false);
+    addEntry("CMAKE_CXX_COMPILER", "/usr/bin/c++", true);
+    addEntry("CMAKE_GENERATOR", "Ninja", true);
+    addEntry("CMAKE_HOME_DIRECTORY", sourceDirectory.path(), true);
+    for (int i = 0; i < 200; ++i)
+        addEntry(QString("SYNTHETIC_OPTION_%1").arg(i), "ON", i % 2);
+    if (!writeJson(replyDir / "cache-v2-synthetic.json",
+                   QJsonObject{{"kind", "cache"}, {"version", version(2, 0)}, {"entries", entries}},
+                   errorMessage)) {
+        return false;
+    }
+
+    // CMake files:
+    QJsonArray inputs{QJsonObject{{"path", "CMakeLists.txt"}},
+                      QJsonObject{{"path", "cmake/SyntheticHelpers.cmake"}}};
+    for (int d = 1; d <= directoryCount; ++d)
+        inputs.append(QJsonObject{{"path", directoryName(d) + "/CMakeLists.txt"}});
+    for (const char *module : {"CMakeCXXInformation.cmake", "CMakeGenericSystem.cmake"}) {
+        inputs.append(QJsonObject{{"path", QString("/usr/share/cmake/Modules/") + module},
+                                  {"isCMake", true},
+                                  {"isExternal", true}});
+    }
+    if (!writeText(sourceDirectory / "cmake/SyntheticHelpers.cmake",
+                   "function(synthetic_helper)\nendfunction()\n", errorMessage)) {
+        return false;
+    }
+    if (!writeJson(replyDir / "cmakeFiles-v1-synthetic.json",
+                   QJsonObject{{"kind", "cmakeFiles"},
+                               {"version", version(1, 0)},
+                               {"paths", paths},
+                               {"inputs", inputs}},
+                   errorMessage)) {
+        return false;
+    }
+
+    // Index:
+    const auto object = [](const QString &kind, const QJsonObject &version, const QString &file) {
+        return QJsonObject{{"kind", kind}, {"version", version}, {"jsonFile", file}};
+    };
+    const QJsonObject index{
+        {"cmake",
+         QJsonObject{{"generator", QJsonObject{{"multiConfig", false}, {"name", "Ninja"}}},
+                     {"paths",
+                      QJsonObject{{"cmake", "/usr/bin/cmake"},
+                                  {"ctest", "/usr/bin/ctest"},
+                                  {"root", "/usr/share/cmake"}}},
+                     {"version",
+                      QJsonObject{{"major", 3}, {"minor", 28}, {"patch", 0}, {"string", "3.28.0"}}}}},
+        {"objects",
+         QJsonArray{object("codemodel", version(2, 6), "codemodel-v2-synthetic.json"),
+                    object("cache", version(2, 0), "cache-v2-synthetic.json"),
+                    object("cmakeFiles", version(1, 0), "cmakeFiles-v1-synthetic.json")}}};
+    return writeJson(replyDir / "index-2026-01-01T00-00-00-0000.json", index, errorMessage);
+}
+
+} // CMakeProjectManager::Internal
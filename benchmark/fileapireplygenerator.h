@@ -0,0 +1,40 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QString>
+
+namespace CMakeProjectManager::Internal {
+
+class ReplyGeneratorOptions
+{
+public:
+    int targets = 100;
+    int targetsPerDirectory = 10;
+    int sourcesPerTarget = 20;
+    int compileGroups = 1;
+    int includes = 50;          // Include paths shared by all targets
+    int defines = 20;           // Defines shared by all targets
+    int backtraceDepth = 3;
+    int executableEvery = 10;   // Every n-th target is an executable
+};
+
+// Writes a synthetic CMake file-api reply (codemodel v2, cache v2, cmakeFiles v1) into
+// buildDirectory and the CMakeLists.txt files it refers to into sourceDirectory.
+class FileApiReplyGenerator
+{
+public:
+    explicit FileApiReplyGenerator(const ReplyGeneratorOptions &options);
+
+    bool generate(const Utils::FilePath &sourceDirectory,
+                  const Utils::FilePath &buildDirectory,
+                  QString *errorMessage) const;
+
+private:
+    ReplyGeneratorOptions m_options;
+};
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,178 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+// Compares the hand-written scanner of cmListFileLexer with the flex generated one on real
+// CMake files and reports the throughput of both. Exits with 1 if any token differs.
+
+#include "../3rdparty/cmake/cmListFileLexer.h"
+
+#include <QByteArray>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QList>
+#include <QTextStream>
+
+#include <limits>
+
+class Token
+{
+public:
+    bool operator==(const Token &other) const
+    {
+        return type == other.type && text == other.text && line == other.line
+               && column == other.column;
+    }
+
+    cmListFileLexer_Type type = cmListFileLexer_Token_None;
+    QByteArray text;
+    int line = 0;
+    int column = 0;
+};
+
+static QList<Token> tokens(const QByteArray &contents, bool fastScan)
+{
+    QList<Token> result;
+    cmListFileLexer *lexer = cmListFileLexer_New();
+    cmListFileLexer_SetFastScan(lexer, fastScan);
+    cmListFileLexer_SetString(lexer, contents.constData(), int(contents.size()));
+    while (cmListFileLexer_Token *token = cmListFileLexer_Scan(lexer))
+        result.append({token->type, QByteArray(token->text, token->length), token->line,
+                       token->column});
+    cmListFileLexer_Delete(lexer);
+    return result;
+}
+
+static qint64 tokenCount(const QByteArray &contents, bool fastScan)
+{
+    qint64 count = 0;
+    cmListFileLexer *lexer = cmListFileLexer_New();
+    cmListFileLexer_SetFastScan(lexer, fastScan);
+    cmListFileLexer_SetString(lexer, contents.constData(), int(contents.size()));
+    while (cmListFileLexer_Scan(lexer))
+        ++count;
+    cmListFileLexer_Delete(lexer);
+    return count;
+}
+
+static QString describe(const Token &token)
+{
+    return QString("%1:%2 type %3 \"%4\"")
+        .arg(token.line)
+        .arg(token.column)
+        .arg(int(token.type))
+        .arg(QString::fromUtf8(token.text));
+}
+
+// Compares both scanners on the file and on all its prefixes up to prefixLimit bytes, which
+// covers the unterminated strings, brackets and comments at the end of the input.
+static bool compare(const QString &fileName, const QByteArray &contents, int prefixLimit,
+                    QTextStream &err)
+{
+    for (qsizetype length = contents.size(); length >= 0; --length) {
+        if (length < contents.size() && length > prefixLimit)
+            length = prefixLimit;
+        const QByteArray input = contents.left(length);
+        const QList<Token> expected = tokens(input, false);
+        const QList<Token> actual = tokens(input, true);
+        for (qsizetype i = 0; i < qMax(expected.size(), actual.size()); ++i) {
+            if (i < expected.size() && i < actual.size() && expected.at(i) == actual.at(i))
+                continue;
+            err << fileName << " (first " << length << " bytes): token " << i << " differs, "
+                << (i < expected.size() ? describe(expected.at(i)) : QString("none"))
+                << " vs. " << (i < actual.size() ? describe(actual.at(i)) : QString("none"))
+                << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+static double megabytesPerSecond(const QList<QByteArray> &files, qint64 bytes, bool fastScan,
+                                 int iterations)
+{
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < iterations; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        qint64 count = 0;
+        for (const QByteArray &contents : files)
+            count += tokenCount(contents, fastScan);
+        best = qMin(best, timer.nsecsElapsed());
+        Q_UNUSED(count)
+    }
+    return best > 0 ? bytes * 1e3 / best : 0;
+}
+
+static QStringList collectFiles(const QStringList &paths)
+{
+    QStringList result;
+    for (const QString &path : paths) {
+        if (!QFileInfo(path).isDir()) {
+            result.append(path);
+            continue;
+        }
+        QDirIterator it(path, {"CMakeLists.txt", "*.cmake"}, QDir::Files,
+                        QDirIterator::Subdirectories);
+        while (it.hasNext())
+            result.append(it.next());
+    }
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("listfilelexerbenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Checks that both CMake list-file scanners produce the same tokens and measures them.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("paths", "CMake files or directories to scan recursively.");
+    const QCommandLineOption iterationsOption("iterations", "Runs, the best one is reported.",
+                                              "n", "5");
+    parser.addOption(iterationsOption);
+    const QCommandLineOption prefixOption(
+        "prefixes", "Also compare all prefixes of files up to <n> bytes.", "n", "512");
+    parser.addOption(prefixOption);
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    const QStringList fileNames = collectFiles(parser.positionalArguments());
+    if (fileNames.isEmpty()) {
+        err << "No CMake files given.\n";
+        return 1;
+    }
+
+    QList<QByteArray> files;
+    qint64 bytes = 0;
+    int mismatches = 0;
+    const int prefixLimit = parser.value(prefixOption).toInt();
+    for (const QString &fileName : fileNames) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        const QByteArray contents = file.readAll();
+        if (!compare(fileName, contents, prefixLimit, err))
+            ++mismatches;
+        files.append(contents);
+        bytes += contents.size();
+    }
+
+    const int iterations = qMax(1, parser.value(iterationsOption).toInt());
+    out << QString("%1 files, %2 kB, %3 mismatches\n")
+               .arg(files.size())
+               .arg(bytes / 1024)
+               .arg(mismatches);
+    out << QString("flex:         %1 MB/s\n")
+               .arg(megabytesPerSecond(files, bytes, false, iterations), 0, 'f', 1);
+    out << QString("hand-written: %1 MB/s\n")
+               .arg(megabytesPerSecond(files, bytes, true, iterations), 0, 'f', 1);
+    return mismatches ? 1 : 0;
+}
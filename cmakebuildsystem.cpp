@@ -8,11 +8,14 @@
 #include "cmakebuildstep.h"
 #include "cmakebuildtarget.h"
 #include "cmakekitaspect.h"
+#include "cmakepackageindex.h"
+#include "cmakeparsetimings.h"
 #include "cmakeprocess.h"
 #include "cmakeproject.h"
 #include "cmakeprojectconstants.h"
 #include "cmakeprojectmanagertr.h"
 #include "cmakespecificsettings.h"
+#include "cmaketoolmanager.h"
 #include "projecttreehelper.h"
 
 #include <android/androidconstants.h>
@@ -40,6 +43,7 @@
 #include <qtsupport/qtsupportconstants.h>
 
 #include <utils/algorithm.h>
+#include <utils/async.h>
 #include <utils/checkablemessagebox.h>
 #include <utils/macroexpander.h>
 #include <utils/mimeconstants.h>
@@ -115,12 +119,33 @@ CMakeBuildSystem::CMakeBuildSystem(CMakeBuildConfiguration *bc)
             &FileApiReader::dataAvailable,
             this,
             &CMakeBuildSystem::handleParsingSucceeded);
+    connect(&m_reader,
+            &FileApiReader::previewAvailable,
+            this,
+            &CMakeBuildSystem::handlePreviewAvailable);
     connect(&m_reader, &FileApiReader::errorOccurred, this, &CMakeBuildSystem::handleParsingFailed);
     connect(&m_reader, &FileApiReader::dirty, this, &CMakeBuildSystem::becameDirty);
     connect(&m_reader, &FileApiReader::debuggingStarted, this, &BuildSystem::debuggingStarted);
 
+    m_updateProjectDataTimer.setSingleShot(true);
+    m_updateProjectDataTimer.setInterval(200);
+    connect(&m_updateProjectDataTimer,
+            &QTimer::timeout,
+            this,
+            &CMakeBuildSystem::updateProjectData);
+
     wireUpConnections();
 
+    // The Find<Package> variables need the keywords of the tool
+    connect(CMakeToolManager::instance(),
+            &CMakeToolManager::cmakeKeywordsLoaded,
+            this,
+            [this](const Id &id) {
+                const CMakeTool *tool = CMakeKitAspect::cmakeTool(target()->kit());
+                if (m_cmakeSymbolsLackKeywords && tool && tool->id() == id)
+                    setupCMakeSymbolsHash();
+            });
+
     m_isMultiConfig = CMakeGeneratorKitAspect::isMultiConfigGenerator(bc->kit());
 }
 
@@ -131,6 +156,10 @@ CMakeBuildSystem::~CMakeBuildSystem()
         future.cancel();
         future.waitForFinished();
     }
+    m_cmakeSymbolsFuture.cancel();
+    m_cmakeSymbolsFuture.waitForFinished();
+    m_symbolIndexFuture.cancel();
+    m_symbolIndexFuture.waitForFinished();
 
     delete m_cppCodeModelUpdater;
     qDeleteAll(m_extraCompilers);
@@ -874,7 +903,7 @@ void CMakeBuildSystem::setParametersAndRequestParse(const BuildDirParameters &pa
     updateReparseParameters(reparseParameters);
 
     m_reader.setParameters(m_parameters);
-
+    loadCMakeSymbolIndex();
 
     if (reparseParameters & REPARSE_URGENT) {
         qCDebug(cmakeBuildSystemLog) << "calling requestReparse";
@@ -976,43 +1005,20 @@ bool CMakeBuildSystem::addFilesPriv(const Utils::FilePaths &filePaths)
 
 bool CMakeBuildSystem::eraseFilesPriv(const Utils::FilePaths &filePaths)
 {
-    QList<const FileNode *> removed;
-    for (auto& filePath : filePaths) {
-        const auto mimeType = Utils::mimeTypeForFile(filePath);
-        auto type = TreeScanner::genericFileType(mimeType, filePath);
-        auto toRemove = new FileNode(filePath, type);
-        toRemove->setIsGenerated(false);
-
-        // To update list
-        removed << toRemove;
-    }
-
-    // Update tree without full rescan run
-    sort(removed, Node::sortByPath);
-
-    // Inplace change m_allFiles in one pass
-
-    auto it = std::lower_bound(m_allFiles.allFiles.begin(),
-                               m_allFiles.allFiles.end(), removed[0], Node::sortByPath);
-    QTC_ASSERT(it != m_allFiles.allFiles.end(), return false);
-
-    int allIdx = static_cast<int>(std::distance(m_allFiles.allFiles.begin(), it));
-    int remIdx = 0;
-    while (allIdx < m_allFiles.allFiles.size() && remIdx < removed.size()) {
-        auto &allNode = m_allFiles.allFiles[allIdx];
-        auto &removeNode = removed[remIdx];
+    if (filePaths.isEmpty())
+        return true;
 
-        if (Node::sortByPath(allNode, removeNode)) {
-            allIdx++;
-        } else if (Node::sortByPath(removeNode, allNode)) {
-            remIdx++;
-        } else {
-            delete allNode;
-            m_allFiles.allFiles.removeAt(allIdx);
-            // We should not increment allIdx here
-            remIdx++;
-        }
-    }
+    // Update tree without full rescan run, in one pass over the scanned files
+    const QSet<FilePath> toRemove = Utils::toSet(filePaths);
+    const auto end = std::remove_if(m_allFiles.allFiles.begin(),
+                                    m_allFiles.allFiles.end(),
+                                    [&toRemove](FileNode *node) {
+                                        if (!toRemove.contains(node->filePath()))
+                                            return false;
+                                        delete node;
+                                        return true;
+                                    });
+    m_allFiles.allFiles.erase(end, m_allFiles.allFiles.end());
 
     // Real deleting occurs after function exit.
     updateProjectDataPriv();
@@ -1022,33 +1028,33 @@ bool CMakeBuildSystem::eraseFilesPriv(const Utils::FilePaths &filePaths)
 
 bool CMakeBuildSystem::renameFilePriv(const Utils::FilePath &filePath, const Utils::FilePath &newFilePath)
 {
-    const auto mimeType = Utils::mimeTypeForFile(filePath);
-    auto type = TreeScanner::genericFileType(mimeType, filePath);
-    auto node = new FileNode(filePath, type);
-    node->setIsGenerated(false);
+    const auto byPath = [](const FileNode *node, const FilePath &path) {
+        return node->filePath() < path;
+    };
 
     // Update tree without full rescan run
     {
         auto it = std::lower_bound(m_allFiles.allFiles.begin(),
                                    m_allFiles.allFiles.end(),
-                                   node,
-                                   Node::sortByPath);
-        if (it == m_allFiles.allFiles.end())
+                                   filePath,
+                                   byPath);
+        if (it == m_allFiles.allFiles.end() || (*it)->filePath() != filePath)
             return false;
 
         // Update data in scanned files and in the project tree
+        const FileType type = (*it)->fileType();
         delete *it;
-        m_allFiles.allFiles.removeAt(static_cast<int>(std::distance(m_allFiles.allFiles.begin(), it)));
+        m_allFiles.allFiles.erase(it);
 
         // We add only one new file. Use std::lower_bound to insert item to right place
-        auto toAdd = new FileNode(newFilePath, node->fileType()); // do not copy parent and other
+        auto toAdd = new FileNode(newFilePath, type); // do not copy parent and other
         toAdd->setIsGenerated(false);
         toAdd->setEnabled(false);
 
         it = std::lower_bound(m_allFiles.allFiles.begin(),
                               m_allFiles.allFiles.end(),
-                              toAdd,
-                              Node::sortByPath);
+                              newFilePath,
+                              byPath);
 
         m_allFiles.allFiles.insert(it, toAdd);
     }
@@ -1060,9 +1066,9 @@ bool CMakeBuildSystem::renameFilePriv(const Utils::FilePath &filePath, const Uti
 
 void CMakeBuildSystem::updateProjectDataPriv()
 {
-    QTimer::singleShot(200, this, [this]() {
-        updateProjectData();
-    });
+    // Adding, removing or renaming several files calls this once per file, the timer
+    // restarts, so the whole batch results in a single update.
+    m_updateProjectDataTimer.start();
 }
 
 
@@ -1193,6 +1199,9 @@ void CMakeBuildSystem::updateProjectData()
 
     QTC_ASSERT(m_treeScanner.isFinished() && !m_reader.isParsing(), return );
 
+    const std::shared_ptr<ParseTimings> timings = m_reader.takeParseTimings();
+    const qint64 updateStart = timings ? timings->elapsedNs() : 0;
+
     buildConfiguration()->project()->setExtraProjectFiles(projectFilesToWatch(m_cmakeFiles));
 
     CMakeConfig patchedConfig = configurationFromCMake();
@@ -1227,7 +1236,13 @@ void CMakeBuildSystem::updateProjectData()
         auto newRoot = m_reader.rootProjectNode(m_allFiles, false);
 
         if (newRoot) {
-            setRootProjectNode(std::move(newRoot));
+            ProjectNode *oldRoot = p->rootProjectNode();
+            if (oldRoot && mergeProjectTree(oldRoot, newRoot.get())) {
+                // Keeps the nodes, and with them the state of the project tree views:
+                qCDebug(cmakeBuildSystemLog) << "Merged the project tree";
+            } else {
+                setRootProjectNode(std::move(newRoot));
+            }
 
             if (QTC_GUARD(p->rootProjectNode())) {
 
@@ -1305,8 +1320,12 @@ void CMakeBuildSystem::updateProjectData()
             rpp.setFlagsForC({kitInfo.cToolChain, cFlags, includeFileBaseDir});
     }
 
-    m_cppCodeModelUpdater->update({p, kitInfo, buildConfiguration()->environment(), rpps},
-                                  m_extraCompilers);
+    {
+        ParseTimings::Phase phase(timings.get(), "C++ code model update");
+        phase.setCount(rpps.size());
+        m_cppCodeModelUpdater->update({p, kitInfo, buildConfiguration()->environment(), rpps},
+                                      m_extraCompilers);
+    }
 
     {
         const bool mergedHeaderPathsAndQmlImportPaths = kit()->value(
@@ -1337,9 +1356,29 @@ void CMakeBuildSystem::updateProjectData()
 
     emit buildConfiguration()->buildTypeChanged();
 
+    if (timings) {
+        timings->record("updateProjectData", updateStart, timings->elapsedNs() - updateStart);
+        reportParseTimings(*timings);
+    }
+
     qCDebug(cmakeBuildSystemLog) << "All CMake project data up to date.";
 }
 
+void CMakeBuildSystem::reportParseTimings(const ParseTimings &timings)
+{
+    if (settings().showParseTimings())
+        appendBuildSystemOutput(addCMakePrefix(timings.report().split('\n')).join('\n'));
+
+    const FilePath traceFile = settings().parseTimingsTraceFile();
+    if (!traceFile.isEmpty()) {
+        const expected_str<qint64> written = traceFile.writeFileContents(timings.chromeTrace());
+        if (!written) {
+            qCWarning(cmakeBuildSystemLog)
+                << "Failed to write parse timings to" << traceFile << written.error();
+        }
+    }
+}
+
 /*
  * TBD: Scenario below must be reworked.
  * 
@@ -1463,6 +1502,10 @@ void CMakeBuildSystem::handleParsingSucceeded(bool restoredFromBackup)
         checkAndReportError(errorMessage);
     }
 
+    // Have the packages ready for the first find_package() completion
+    CMakePackageIndex::prefetch(configurationFromCMake(),
+                                cmakeBuildConfiguration()->configureEnvironment());
+
     if (const CMakeTool *tool = m_parameters.cmakeTool())
         m_ctestPath = tool->cmakeExecutable().withNewPath(m_reader.ctestPath());
 
@@ -1479,6 +1522,21 @@ void CMakeBuildSystem::handleParsingSucceeded(bool restoredFromBackup)
     combineScanAndParse(restoredFromBackup);
 }
 
+void CMakeBuildSystem::handlePreviewAvailable()
+{
+    std::unique_ptr<CMakeProjectNode> preview = m_reader.takePreviewProjectNode();
+
+    // Only replaces an empty tree, an existing one knows the target sources already:
+    if (!preview || !m_reader.isParsing() || !buildConfiguration()->isActive()
+        || project()->rootProjectNode()) {
+        return;
+    }
+
+    qCDebug(cmakeBuildSystemLog) << "Showing the project tree before the targets are loaded";
+    project()->setDisplayName(preview->displayName());
+    setRootProjectNode(std::move(preview));
+}
+
 void CMakeBuildSystem::handleParsingFailed(const QString &msg)
 {
     setError(msg);
@@ -1558,130 +1616,80 @@ void CMakeBuildSystem::wireUpConnections()
     }
 }
 
-void CMakeBuildSystem::setupCMakeSymbolsHash()
+void CMakeBuildSystem::loadCMakeSymbolIndex()
 {
-    m_cmakeSymbolsHash.clear();
-
-    m_projectKeywords.functions.clear();
-    m_projectKeywords.variables.clear();
-
-    auto handleFunctionMacroOption = [&](const CMakeFileInfo &cmakeFile,
-                                         const cmListFileFunction &func) {
-        if (func.LowerCaseName() != "function" && func.LowerCaseName() != "macro"
-            && func.LowerCaseName() != "option")
-            return;
-
-        if (func.Arguments().size() == 0)
-            return;
-        auto arg = func.Arguments()[0];
-
-        Utils::Link link;
-        link.targetFilePath = cmakeFile.path;
-        link.targetLine = arg.Line;
-        link.targetColumn = arg.Column - 1;
-        m_cmakeSymbolsHash.insert(QString::fromUtf8(arg.Value), link);
-
-        if (func.LowerCaseName() == "option")
-            m_projectKeywords.variables[QString::fromUtf8(arg.Value)] = FilePath();
-        else
-            m_projectKeywords.functions[QString::fromUtf8(arg.Value)] = FilePath();
-    };
-
-    m_projectImportedTargets.clear();
-    auto handleImportedTargets = [&](const CMakeFileInfo &cmakeFile,
-                                     const cmListFileFunction &func) {
-        if (func.LowerCaseName() != "add_library")
-            return;
-
-        if (func.Arguments().size() == 0)
-            return;
-        auto arg = func.Arguments()[0];
-        const QString targetName = QString::fromUtf8(arg.Value);
+    // Only needed until the first parse delivers the symbols
+    if (m_symbolIndex || m_symbolIndexFuture.isRunning())
+        return;
 
-        const bool haveImported = Utils::contains(func.Arguments(), [](const auto &arg) {
-            return arg.Value == "IMPORTED";
-        });
-        if (haveImported && !targetName.contains("${")) {
-            m_projectImportedTargets << targetName;
+    const FilePath buildDirectory = m_parameters.buildDirectory;
+    const FilePath sourceDirectory = m_parameters.sourceDirectory;
+    m_symbolIndexFuture = Utils::asyncRun(ProjectExplorerPlugin::sharedThreadPool(),
+                                          [buildDirectory, sourceDirectory] {
+                                              return CMakeSymbolIndex::read(buildDirectory,
+                                                                            sourceDirectory);
+                                          });
+    Utils::onResultReady(m_symbolIndexFuture,
+                         this,
+                         [this](const std::optional<CMakeSymbolIndex> &index) {
+                             if (!index || m_symbolIndex)
+                                 return;
+                             qCDebug(cmakeBuildSystemLog) << "Restored" << index->entries().size()
+                                                          << "CMake symbols from the index";
+                             m_symbolIndex = std::make_shared<const CMakeSymbolIndex>(*index);
+                             // Allow navigation before the project is parsed
+                             if (m_cmakeSymbolsHash.isEmpty())
+                                 m_cmakeSymbolsHash = m_symbolIndex->navigationLinks();
+                         });
+}
 
-            // Allow navigation to the imported target
-            Utils::Link link;
-            link.targetFilePath = cmakeFile.path;
-            link.targetLine = arg.Line;
-            link.targetColumn = arg.Column - 1;
-            m_cmakeSymbolsHash.insert(targetName, link);
-        }
-    };
+void CMakeBuildSystem::setupCMakeSymbolsHash()
+{
+    CMakeSymbolsInput input;
+    input.cmakeFiles = m_cmakeFiles;
+    input.cache = m_cmakeFileSymbols;
 
     // Handle project targets, unfortunately the CMake file-api doesn't deliver the
     // column of the target, just the line. Make sure to find it out
-    QHash<FilePath, QPair<int, QString>> projectTargetsSourceAndLine;
     for (const auto &target : std::as_const(buildTargets())) {
         if (target.targetType == TargetType::UtilityType)
             continue;
         if (target.backtrace.isEmpty())
             continue;
 
-        projectTargetsSourceAndLine.insert(target.backtrace.last().path,
-                                           {target.backtrace.last().line, target.title});
+        input.projectTargets.insert(target.backtrace.last().path,
+                                    {target.backtrace.last().line, target.title});
     }
-    auto handleProjectTargets = [&](const CMakeFileInfo &cmakeFile, const cmListFileFunction &func) {
-        const auto it = projectTargetsSourceAndLine.find(cmakeFile.path);
-        if (it == projectTargetsSourceAndLine.end() || it->first != func.Line())
-            return;
-
-        if (func.Arguments().size() == 0)
-            return;
-        auto arg = func.Arguments()[0];
-
-        Utils::Link link;
-        link.targetFilePath = cmakeFile.path;
-        link.targetLine = arg.Line;
-        link.targetColumn = arg.Column - 1;
-        m_cmakeSymbolsHash.insert(it->second, link);
-    };
 
     // Gather the exported variables for the Find<Package> CMake packages
-    m_projectFindPackageVariables.clear();
-
-    const std::string fphsFunctionName = "find_package_handle_standard_args";
     CMakeKeywords keywords;
     if (auto tool = CMakeKitAspect::cmakeTool(target()->kit()))
         keywords = tool->keywords();
-    QSet<std::string> fphsFunctionArgs;
-    if (keywords.functionArgs.contains(QString::fromStdString(fphsFunctionName))) {
-        const QList<std::string> args
-            = Utils::transform(keywords.functionArgs.value(QString::fromStdString(fphsFunctionName)),
-                               &QString::toStdString);
-        fphsFunctionArgs = Utils::toSet(args);
-    }
-
-    auto handleFindPackageVariables = [&](const CMakeFileInfo &cmakeFile, const cmListFileFunction &func) {
-        if (func.LowerCaseName() != fphsFunctionName)
-            return;
-
-        if (func.Arguments().size() == 0)
-            return;
-        auto firstArgument = func.Arguments()[0];
-        const auto filteredArguments = Utils::filtered(func.Arguments(), [&](const auto &arg) {
-            return !fphsFunctionArgs.contains(arg.Value) && arg != firstArgument;
-        });
-
-        for (const auto &arg : filteredArguments) {
-            const QString value = QString::fromUtf8(arg.Value);
-            if (value.contains("${") || (value.startsWith('"') && value.endsWith('"'))
-                || (value.startsWith("'") && value.endsWith("'")))
-                continue;
-
-            m_projectFindPackageVariables << value;
-
-            Utils::Link link;
-            link.targetFilePath = cmakeFile.path;
-            link.targetLine = arg.Line;
-            link.targetColumn = arg.Column - 1;
-            m_cmakeSymbolsHash.insert(value, link);
-        }
-    };
+    input.findPackageKeywords = Utils::toSet(
+        keywords.functionArgs.value("find_package_handle_standard_args"));
+    m_cmakeSymbolsLackKeywords = keywords.functionArgs.isEmpty();
+    input.buildDirectory = m_parameters.buildDirectory;
+    input.sourceDirectory = m_parameters.sourceDirectory;
+    input.previousIndex = m_symbolIndex;
+
+    // The symbols only serve the editor, so they are collected in the background and
+    // replace the ones of the previous parse when done.
+    m_cmakeSymbolsFuture.cancel();
+    m_cmakeSymbolsFuture = Utils::asyncRun(ProjectExplorerPlugin::sharedThreadPool(),
+                                           collectCMakeSymbols, input);
+    Utils::onResultReady(m_cmakeSymbolsFuture, this, [this](const CMakeSymbols &symbols) {
+        qCDebug(cmakeBuildSystemLog) << "CMake symbols collected, scanned"
+                                     << symbols.scannedFiles << "of" << symbols.cache.size()
+                                     << "files";
+        m_cmakeSymbolsHash = symbols.symbols;
+        m_projectKeywords.functions = symbols.keywords.functions;
+        m_projectKeywords.variables = symbols.keywords.variables;
+        m_projectImportedTargets = symbols.importedTargets;
+        m_projectFindPackageVariables = symbols.findPackageVariables;
+        m_cmakeFileSymbols = symbols.cache;
+        m_symbolIndexFuture.cancel();
+        m_symbolIndex = symbols.index;
+    });
 
     // Prepare a hash with all .cmake files
     m_dotCMakeFilesHash.clear();
@@ -1729,18 +1737,12 @@ void CMakeBuildSystem::setupCMakeSymbolsHash()
         }
     };
 
+    // These only look at the file names and are needed right away for the Qt version
+    // detection in updateProjectData().
     for (const auto &cmakeFile : std::as_const(m_cmakeFiles)) {
-        for (const auto &func : cmakeFile.cmakeListFile.Functions) {
-            handleFunctionMacroOption(cmakeFile, func);
-            handleImportedTargets(cmakeFile, func);
-            handleProjectTargets(cmakeFile, func);
-            handleFindPackageVariables(cmakeFile, func);
-        }
         handleDotCMakeFiles(cmakeFile);
         handleFindPackageCMakeFiles(cmakeFile);
     }
-
-    m_projectFindPackageVariables.removeDuplicates();
 }
 
 void CMakeBuildSystem::ensureBuildDirectory(const BuildDirParameters &parameters)
@@ -5,6 +5,7 @@
 
 #include "builddirparameters.h"
 #include "cmakebuildtarget.h"
+#include "cmakesymbols.h"
 #include "fileapireader.h"
 #include "simplefileapireader.h"
 
@@ -13,6 +14,9 @@
 
 #include <utils/temporarydirectory.h>
 
+#include <QFuture>
+#include <QTimer>
+
 namespace ProjectExplorer {
     class ExtraCompiler;
     class FolderNode;
@@ -31,6 +35,8 @@ class CMakeProject;
 
 namespace Internal {
 
+class ParseTimings;
+
 // --------------------------------------------------------------------
 // CMakeBuildSystem:
 // --------------------------------------------------------------------
@@ -130,6 +136,7 @@ public:
     QString warning() const;
 
     const QHash<QString, Utils::Link> &cmakeSymbolsHash() const { return m_cmakeSymbolsHash; }
+    std::shared_ptr<const CMakeSymbolIndex> symbolIndex() const { return m_symbolIndex; }
     CMakeKeywords projectKeywords() const { return m_projectKeywords; }
     QStringList projectImportedTargets() const { return m_projectImportedTargets; }
     QStringList projectFindPackageVariables() const { return m_projectFindPackageVariables; }
@@ -196,6 +203,7 @@ private:
     void updateCMakeConfiguration(QString &errorMessage);
 
     void updateProjectData();
+    void reportParseTimings(const ParseTimings &timings);
     void updateFallbackProjectData();
     QList<ProjectExplorer::ExtraCompiler *> findExtraCompilers();
     void updateQmlJSCodeModel(const QStringList &extraHeaderPaths,
@@ -205,6 +213,7 @@ private:
     void updateFileSystemNodes();
 
     void handleParsingSucceeded(bool restoredFromBackup);
+    void handlePreviewAvailable();
     void handleParsingFailed(const QString &msg);
 
     void wireUpConnections();
@@ -219,6 +228,7 @@ private:
     void runCTest();
 
     void setupCMakeSymbolsHash();
+    void loadCMakeSymbolIndex();
 
     struct ProjectFileArgumentPosition
     {
@@ -232,6 +242,7 @@ private:
 
     ProjectExplorer::TreeScanner m_treeScanner;
     ProjectExplorer::TreeScanner::Result m_allFiles;
+    QTimer m_updateProjectDataTimer; // Coalesces the updates after adding or removing files
     QHash<QString, bool> m_mimeBinaryCache;
 
     bool m_waitingForScan = false;
@@ -249,9 +260,14 @@ private:
     QHash<QString, Utils::Link> m_cmakeSymbolsHash;
     QHash<QString, Utils::Link> m_dotCMakeFilesHash;
     QHash<QString, Utils::Link> m_findPackagesFilesHash;
+    CMakeFileSymbolsCache m_cmakeFileSymbols;
+    QFuture<CMakeSymbols> m_cmakeSymbolsFuture;
+    std::shared_ptr<const CMakeSymbolIndex> m_symbolIndex;
+    QFuture<std::optional<CMakeSymbolIndex>> m_symbolIndexFuture;
     CMakeKeywords m_projectKeywords;
     QStringList m_projectImportedTargets;
     QStringList m_projectFindPackageVariables;
+    bool m_cmakeSymbolsLackKeywords = false; // Set up before the keywords were loaded
 
     QHash<QString, ProjectFileArgumentPosition> m_filesToBeRenamed;
 
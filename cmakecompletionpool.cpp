@@ -0,0 +1,232 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cmakecompletionpool.h"
+
+#include "cmaketoolmanager.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <utility>
+
+using namespace TextEditor;
+using namespace Utils;
+
+namespace CMakeProjectManager::Internal {
+
+// Prefixes of this length also match inside of words, see GenericProposalModel::filter()
+const int minimumInfixLength = 3;
+
+CMakeCompletionFilter::CMakeCompletionFilter(const QString &prefix,
+                                             FuzzyMatcher::CaseSensitivity caseSensitivity)
+    : m_caseSensitivity(caseSensitivity)
+{
+    if (prefix.size() < minimumInfixLength)
+        return;
+    m_prefix = prefix;
+    m_regExp = FuzzyMatcher::createRegExp(prefix, caseSensitivity);
+    // The wildcards are the only characters of the prefix the regular expression does not
+    // require literally
+    for (const QChar c : prefix) {
+        if (c != '*' && c != '?')
+            m_fuzzyCharacters.append(c.toCaseFolded());
+    }
+}
+
+bool CMakeCompletionFilter::accepts(const QString &word) const
+{
+    if (m_prefix.isEmpty())
+        return true;
+    return word.startsWith(m_prefix, Qt::CaseInsensitive) || acceptsInfix(word);
+}
+
+static bool containsInOrder(const QString &word, const QString &caseFoldedCharacters)
+{
+    qsizetype pos = 0;
+    for (const QChar c : caseFoldedCharacters) {
+        while (pos < word.size() && word.at(pos).toCaseFolded() != c)
+            ++pos;
+        if (pos == word.size())
+            return false;
+        ++pos;
+    }
+    return true;
+}
+
+bool CMakeCompletionFilter::acceptsInfix(const QString &word) const
+{
+    if (m_prefix.isEmpty())
+        return true;
+    if (word.contains(m_prefix, Qt::CaseInsensitive))
+        return true;
+    // Most words fail this check, which is a lot cheaper than the regular expression
+    return containsInOrder(word, m_fuzzyCharacters) && m_regExp.match(word).hasMatch();
+}
+
+bool CMakeCompletionFilter::covers(const QString &prefix) const
+{
+    return m_prefix.isEmpty() || prefix.startsWith(m_prefix, Qt::CaseInsensitive);
+}
+
+// The recently used pools, keyed by the data of the word sets they were built for. The
+// cache keeps a copy of each set, so the data cannot be freed and reused for another set.
+template<typename Words>
+class PoolCache
+{
+public:
+    using Pool = std::shared_ptr<const CMakeCompletionPool>;
+
+    Pool pool(const Words &words, const std::function<Pool(const Words &)> &create)
+    {
+        QMutexLocker locker(&m_mutex);
+        for (qsizetype i = 0; i < m_pools.size(); ++i) {
+            if (m_pools.at(i).first.isSharedWith(words)) {
+                m_pools.move(i, 0);
+                return m_pools.first().second;
+            }
+        }
+        const Pool result = create(words);
+        m_pools.prepend({words, result});
+        if (m_pools.size() > maxPools)
+            m_pools.removeLast();
+        return result;
+    }
+
+private:
+    // A CMake tool and a project or two contribute a dozen sets each
+    static const qsizetype maxPools = 64;
+
+    QMutex m_mutex;
+    QList<QPair<Words, Pool>> m_pools;
+};
+
+std::shared_ptr<const CMakeCompletionPool> CMakeCompletionPool::forWords(
+    const QStringList &words)
+{
+    static PoolCache<QStringList> cache;
+    return cache.pool(words, [](const QStringList &words) {
+        auto pool = std::make_shared<CMakeCompletionPool>();
+        pool->m_entries.reserve(words.size());
+        for (const QString &word : words)
+            pool->m_entries.append({word, {}});
+        pool->sortEntries();
+        return pool;
+    });
+}
+
+std::shared_ptr<const CMakeCompletionPool> CMakeCompletionPool::forWords(
+    const QSet<QString> &words)
+{
+    static PoolCache<QSet<QString>> cache;
+    return cache.pool(words, [](const QSet<QString> &words) {
+        auto pool = std::make_shared<CMakeCompletionPool>();
+        pool->m_entries.reserve(words.size());
+        for (const QString &word : words)
+            pool->m_entries.append({word, {}});
+        pool->sortEntries();
+        return pool;
+    });
+}
+
+std::shared_ptr<const CMakeCompletionPool> CMakeCompletionPool::forWords(
+    const QMap<QString, FilePath> &words)
+{
+    static PoolCache<QMap<QString, FilePath>> cache;
+    return cache.pool(words, [](const QMap<QString, FilePath> &words) {
+        auto pool = std::make_shared<CMakeCompletionPool>();
+        pool->m_markDownDetails = true;
+        pool->m_entries.reserve(words.size());
+        for (auto it = words.cbegin(); it != words.cend(); ++it) {
+            pool->m_entries.append({it.key(),
+                                    it.value().isEmpty()
+                                        ? QString()
+                                        : CMakeToolManager::toolTipForRstHelpFile(it.value())});
+        }
+        pool->sortEntries();
+        return pool;
+    });
+}
+
+void CMakeCompletionPool::sortEntries()
+{
+    std::sort(m_entries.begin(), m_entries.end(), [](const Entry &a, const Entry &b) {
+        return a.text.compare(b.text, Qt::CaseInsensitive) < 0;
+    });
+}
+
+QList<AssistProposalItemInterface *> CMakeCompletionPool::createItems(
+    const QIcon &icon, const CMakeCompletionFilter &filter) const
+{
+    // The words starting with the prefix are next to each other, a binary search finds them.
+    // Only the other words need to be checked for matching inside.
+    auto prefixBegin = m_entries.cbegin();
+    auto prefixEnd = m_entries.cbegin();
+    if (filter.isActive()) {
+        const QString &prefix = filter.prefix();
+        const auto head = [&prefix](const Entry &entry) {
+            return QStringView(entry.text).left(prefix.size());
+        };
+        prefixBegin = std::lower_bound(m_entries.cbegin(), m_entries.cend(), prefix,
+                                       [&head](const Entry &entry, const QString &value) {
+                                           return head(entry).compare(value, Qt::CaseInsensitive)
+                                                  < 0;
+                                       });
+        prefixEnd = std::upper_bound(prefixBegin, m_entries.cend(), prefix,
+                                     [&head](const QString &value, const Entry &entry) {
+                                         return head(entry).compare(value, Qt::CaseInsensitive)
+                                                > 0;
+                                     });
+    }
+
+    QList<AssistProposalItemInterface *> list;
+    if (!filter.isActive())
+        list.reserve(m_entries.size());
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        const bool isPrefixMatch = it >= prefixBegin && it < prefixEnd;
+        if (!isPrefixMatch && !filter.acceptsInfix(it->text))
+            continue;
+        AssistProposalItem *item = m_markDownDetails ? new MarkDownAssitProposalItem
+                                                     : new AssistProposalItem;
+        item->setText(it->text);
+        if (!it->detail.isEmpty())
+            item->setDetail(it->detail);
+        item->setIcon(icon);
+        list << item;
+    }
+    return list;
+}
+
+CMakeCompletionModel::CMakeCompletionModel(const CMakeCompletionFilter &filter,
+                                           const QList<ItemSource> &sources,
+                                           const Items &fixedItems)
+    : m_filter(filter)
+    , m_sources(sources)
+    , m_fixedItems(fixedItems)
+{
+    createItems();
+}
+
+void CMakeCompletionModel::filter(const QString &prefix)
+{
+    if (!m_filter.covers(prefix)) {
+        m_filter = CMakeCompletionFilter(prefix, m_filter.caseSensitivity());
+        createItems();
+    }
+    GenericProposalModel::filter(prefix);
+}
+
+void CMakeCompletionModel::createItems()
+{
+    Items items;
+    for (const ItemSource &source : std::as_const(m_sources))
+        items.append(source(m_filter, items));
+
+    // The model deletes the items it holds, except for the replaced ones:
+    const Items replacedItems = std::exchange(m_filteredItems, items);
+    loadContent(m_fixedItems + m_filteredItems);
+    qDeleteAll(replacedItems);
+}
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,125 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <texteditor/codeassist/assistproposalitem.h>
+#include <texteditor/codeassist/genericproposalmodel.h>
+
+#include <utils/filepath.h>
+#include <utils/fuzzymatcher.h>
+
+#include <QIcon>
+#include <QList>
+#include <QMap>
+#include <QRegularExpression>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+
+namespace CMakeProjectManager::Internal {
+
+struct MarkDownAssitProposalItem : public TextEditor::AssistProposalItem
+{
+    Qt::TextFormat detailFormat() const override { return Qt::MarkdownText; }
+};
+
+// Decides which words can end up in the proposal for the typed prefix.
+//
+// The proposal model shows the words that start with the prefix, and from three characters
+// on also the ones that contain it or match it fuzzily. The words accepted for a prefix of
+// three or more characters thus include all the ones the model shows while the prefix grows.
+// Shorter prefixes accept everything.
+class CMakeCompletionFilter
+{
+public:
+    CMakeCompletionFilter() = default;
+    CMakeCompletionFilter(const QString &prefix,
+                          Utils::FuzzyMatcher::CaseSensitivity caseSensitivity);
+
+    bool isActive() const { return !m_prefix.isEmpty(); }
+    const QString &prefix() const { return m_prefix; }
+    Utils::FuzzyMatcher::CaseSensitivity caseSensitivity() const { return m_caseSensitivity; }
+
+    bool accepts(const QString &word) const;
+    // Like accepts(), for words that do not start with the prefix
+    bool acceptsInfix(const QString &word) const;
+    // Whether the accepted words include the ones the proposal model shows for prefix
+    bool covers(const QString &prefix) const;
+
+private:
+    QString m_prefix; // Only set if long enough to filter
+    QString m_fuzzyCharacters; // The ones a fuzzy match contains in this order
+    QRegularExpression m_regExp;
+    Utils::FuzzyMatcher::CaseSensitivity m_caseSensitivity
+        = Utils::FuzzyMatcher::CaseSensitivity::CaseInsensitive;
+};
+
+// The completion data of a set of words, like the variables or properties known to a CMake
+// tool. It is built once per set and shared by all completion requests, which only create
+// the items for the words the filter accepts.
+//
+// The sets are recognized by sharing their data with the one a pool was built for, so the
+// pools of the keywords of a CMake tool or of the symbols of a project are reused until
+// these change.
+class CMakeCompletionPool
+{
+public:
+    static std::shared_ptr<const CMakeCompletionPool> forWords(const QStringList &words);
+    static std::shared_ptr<const CMakeCompletionPool> forWords(const QSet<QString> &words);
+    // Words with the help file that documents them, the details are rendered from these
+    static std::shared_ptr<const CMakeCompletionPool> forWords(
+        const QMap<QString, Utils::FilePath> &words);
+
+    qsizetype size() const { return m_entries.size(); }
+
+    QList<TextEditor::AssistProposalItemInterface *> createItems(
+        const QIcon &icon, const CMakeCompletionFilter &filter) const;
+
+private:
+    class Entry
+    {
+    public:
+        QString text;
+        QString detail;
+    };
+
+    void sortEntries();
+
+    QList<Entry> m_entries; // Sorted case insensitively, to find the prefix matches quickly
+    bool m_markDownDetails = false;
+};
+
+// The model of a completion proposal. It holds the items the filter of the request accepts,
+// which cover all the prefixes starting with the one of the request. So the model only needs
+// to filter them while the prefix grows, and only creates them again from their sources when
+// the prefix gets shorter.
+class CMakeCompletionModel : public TextEditor::GenericProposalModel
+{
+public:
+    using Items = QList<TextEditor::AssistProposalItemInterface *>;
+    // Creates the items the filter accepts. Gets the items of the sources before it, to add
+    // details to these.
+    using ItemSource = std::function<Items(const CMakeCompletionFilter &filter,
+                                           const Items &previousItems)>;
+
+    // Takes the fixed items, which do not depend on the prefix, like files and snippets
+    CMakeCompletionModel(const CMakeCompletionFilter &filter,
+                         const QList<ItemSource> &sources,
+                         const Items &fixedItems);
+
+    void filter(const QString &prefix) override;
+
+private:
+    void createItems();
+
+    CMakeCompletionFilter m_filter;
+    QList<ItemSource> m_sources;
+    Items m_fixedItems;
+    Items m_filteredItems;
+};
+
+} // CMakeProjectManager::Internal
@@ -8,9 +8,9 @@
 #include "cmakebuildsystem.h"
 #include "cmakefilecompletionassist.h"
 #include "cmakeindenter.h"
+#include "cmakelistfileview.h"
 #include "cmakeprojectconstants.h"
 
-#include "3rdparty/cmake/cmListFileCache.h"
 
 #include <coreplugin/actionmanager/actioncontainer.h>
 #include <coreplugin/actionmanager/actionmanager.h>
@@ -48,20 +48,19 @@ namespace CMakeProjectManager::Internal {
 
 class CMakeEditor : public TextEditor::BaseTextEditor
 {
-    CMakeKeywords m_keywords;
+    mutable CMakeKeywords m_keywords;
 public:
-    CMakeEditor();
     void contextHelp(const HelpCallback &callback) const final;
 };
 
-CMakeEditor::CMakeEditor()
-{
-    if (auto tool = CMakeToolManager::defaultProjectOrDefaultCMakeTool())
-        m_keywords = tool->keywords();
-}
-
 void CMakeEditor::contextHelp(const HelpCallback &callback) const
 {
+    // The keywords of the CMake tool might still be loading when the editor is opened
+    if (m_keywords.functions.isEmpty()) {
+        if (auto tool = CMakeToolManager::defaultProjectOrDefaultCMakeTool())
+            m_keywords = tool->keywords();
+    }
+
     auto helpPrefix = [this](const QString &word) {
         if (m_keywords.includeStandardModules.contains(word))
             return "module/";
@@ -166,34 +165,30 @@ static bool isValidIdentifierChar(const QChar &chr)
 
 QHash<QString, Utils::Link> getLocalSymbolsHash(const QByteArray &content, const Utils::FilePath &filePath, QString &projectName)
 {
-    cmListFile cmakeListFile;
-    if (!content.isEmpty()) {
-        std::string errorString;
-        const std::string fileName = "buffer";
-        if (!cmakeListFile.ParseString(content.toStdString(), fileName, errorString))
-            return {};
-    }
+    CMakeListFileView cmakeListFile;
+    if (!content.isEmpty() && !cmakeListFile.parse(content))
+        return {};
 
     QHash<QString, Utils::Link> hash;
-    for (const auto &func : cmakeListFile.Functions) {
-        if (func.LowerCaseName() == "project" && func.Arguments().size() > 0) {
-            projectName = QString::fromUtf8(func.Arguments()[0].Value);
+    for (const ListFileFunction &func : cmakeListFile.functions()) {
+        if (func.lowerCaseName == "project" && !func.arguments.empty()) {
+            projectName = func.arguments[0].toString();
             continue;
         }
 
-        if (func.LowerCaseName() != "function" && func.LowerCaseName() != "macro"
-            && func.LowerCaseName() != "set" && func.LowerCaseName() != "option")
+        if (func.lowerCaseName != "function" && func.lowerCaseName != "macro"
+            && func.lowerCaseName != "set" && func.lowerCaseName != "option")
             continue;
 
-        if (func.Arguments().size() == 0)
+        if (func.arguments.empty())
             continue;
-        auto arg = func.Arguments()[0];
+        const ListFileArgument &arg = func.arguments[0];
 
         Utils::Link link;
         link.targetFilePath = filePath;
-        link.targetLine = arg.Line;
-        link.targetColumn = arg.Column - 1;
-        hash.insert(QString::fromUtf8(arg.Value), link);
+        link.targetLine = arg.line;
+        link.targetColumn = arg.column - 1;
+        hash.insert(arg.toString(), link);
     }
     return hash;
 }
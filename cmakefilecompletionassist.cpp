@@ -6,13 +6,14 @@
 #include "cmakebuildsystem.h"
 #include "cmakebuildtarget.h"
 #include "cmakebuildconfiguration.h"
+#include "cmakecompletionpool.h"
 #include "cmakeconfigitem.h"
+#include "cmakefilecompletionmodel.h"
+#include "cmakepackageindex.h"
 #include "cmakeprojectconstants.h"
 #include "cmaketool.h"
 #include "cmaketoolmanager.h"
 
-#include "3rdparty/cmake/cmListFileCache.h"
-
 #include <projectexplorer/project.h>
 #include <projectexplorer/projectexplorerconstants.h>
 #include <projectexplorer/projectexplorericons.h>
@@ -23,6 +24,7 @@
 
 #include <texteditor/codeassist/assistinterface.h>
 #include <texteditor/codeassist/genericproposal.h>
+#include <texteditor/completionsettings.h>
 #include <texteditor/texteditorsettings.h>
 
 #include <utils/async.h>
@@ -158,32 +160,18 @@ static int findPathStart(const AssistInterface *interface)
     return ++pos;
 }
 
-struct MarkDownAssitProposalItem : public AssistProposalItem
-{
-    Qt::TextFormat detailFormat() const override { return Qt::MarkdownText; }
-};
-
 template<typename T>
-static QList<AssistProposalItemInterface *> generateList(const T &words, const QIcon &icon)
+static QList<AssistProposalItemInterface *> generateList(const T &words,
+                                                         const QIcon &icon,
+                                                         const CMakeCompletionFilter &filter)
 {
-    return transform<QList>(words, [&icon](const QString &word) -> AssistProposalItemInterface * {
+    QList<AssistProposalItemInterface *> list;
+    for (const QString &word : words) {
+        if (!filter.accepts(word))
+            continue;
         AssistProposalItem *item = new AssistProposalItem();
         item->setText(word);
         item->setIcon(icon);
-        return item;
-    });
-}
-
-static QList<AssistProposalItemInterface *> generateList(const QMap<QString, FilePath> &words,
-                                                         const QIcon &icon)
-{
-    QList<AssistProposalItemInterface *> list;
-    for (auto it = words.cbegin(); it != words.cend(); ++it) {
-        MarkDownAssitProposalItem *item = new MarkDownAssitProposalItem();
-        item->setText(it.key());
-        if (!it.value().isEmpty())
-            item->setDetail(CMakeToolManager::toolTipForRstHelpFile(it.value()));
-        item->setIcon(icon);
         list << item;
     }
     return list;
@@ -192,6 +180,7 @@ static QList<AssistProposalItemInterface *> generateList(const QMap<QString, Fil
 static QList<AssistProposalItemInterface *> generateList(
     const CMakeConfig &cache,
     const QIcon &icon,
+    const CMakeCompletionFilter &filter,
     const QList<AssistProposalItemInterface *> &existingList)
 {
     QHash<QString, AssistProposalItemInterface *> hash;
@@ -219,6 +208,8 @@ static QList<AssistProposalItemInterface *> generateList(
             continue;
 
         QString text = QString::fromUtf8(it->key);
+        if (!filter.accepts(text))
+            continue;
         if (!hash.contains(text)) {
             MarkDownAssitProposalItem *item = new MarkDownAssitProposalItem();
             item->setText(text);
@@ -238,6 +229,18 @@ static QList<AssistProposalItemInterface *> generateList(
     return list;
 }
 
+static FuzzyMatcher::CaseSensitivity fuzzyCaseSensitivity()
+{
+    switch (TextEditorSettings::completionSettings().m_caseSensitivity) {
+    case TextEditor::CaseSensitive:
+        return FuzzyMatcher::CaseSensitivity::CaseSensitive;
+    case TextEditor::FirstLetterCaseSensitive:
+        return FuzzyMatcher::CaseSensitivity::FirstLetterCaseSensitive;
+    default:
+        return FuzzyMatcher::CaseSensitivity::CaseInsensitive;
+    }
+}
+
 static int addFilePathItems(const AssistInterface *interface,
                             QList<AssistProposalItemInterface *> &items,
                             int symbolStartPos)
@@ -278,42 +281,11 @@ static int addFilePathItems(const AssistInterface *interface,
     return startPos;
 }
 
-static cmListFile parseCMakeListFromBuffer(const QByteArray &content)
+static void updateCMakeConfigurationWithLocalData(
+    CMakeConfig &cmakeCache,
+    const QList<QPair<QByteArray, QByteArray>> &searchPathUpdates,
+    const FilePath &currentDir)
 {
-    cmListFile cmakeListFile;
-    std::string errorString;
-    if (!content.isEmpty()) {
-        const std::string fileName = "buffer";
-        if (!cmakeListFile.ParseString(content.toStdString(), fileName, errorString))
-            return {};
-    }
-    return cmakeListFile;
-}
-
-static QPair<QStringList, QStringList> getLocalFunctionsAndVariables(const cmListFile &cmakeListFile)
-{
-    QStringList variables;
-    QStringList functions;
-    for (const auto &func : cmakeListFile.Functions) {
-        if (func.Arguments().size() == 0)
-            continue;
-
-        if (func.LowerCaseName() == "macro" || func.LowerCaseName() == "function")
-            functions << QString::fromUtf8(func.Arguments()[0].Value);
-        if (func.LowerCaseName() == "set" || func.LowerCaseName() == "option")
-            variables << QString::fromUtf8(func.Arguments()[0].Value);
-    }
-    return {functions, variables};
-}
-
-static void updateCMakeConfigurationWithLocalData(CMakeConfig &cmakeCache,
-                                                  const cmListFile &cmakeListFile,
-                                                  const FilePath &currentDir)
-{
-    auto isValidCMakeVariable = [](const std::string &var) {
-        return var == "CMAKE_PREFIX_PATH" || var == "CMAKE_MODULE_PATH";
-    };
-
     const FilePath projectDir = ProjectTree::currentBuildSystem()->projectDirectory();
     auto updateDirVariables = [currentDir, projectDir, cmakeCache](QByteArray &value) {
         value.replace("${CMAKE_CURRENT_SOURCE_DIR}", currentDir.path().toUtf8());
@@ -335,103 +307,12 @@ static void updateCMakeConfigurationWithLocalData(CMakeConfig &cmakeCache,
         }
     };
 
-    for (const auto &func : cmakeListFile.Functions) {
-        const bool isSet = func.LowerCaseName() == "set" && func.Arguments().size() > 1;
-        const bool isList = func.LowerCaseName() == "list" && func.Arguments().size() > 2;
-        if (!isSet && !isList)
-            continue;
-
-        QByteArray key;
-        QByteArray value;
-        if (isSet) {
-            const auto firstArg = func.Arguments()[0];
-            const auto secondArg = func.Arguments()[1];
-            if (!isValidCMakeVariable(firstArg.Value))
-                continue;
-            key = QByteArray::fromStdString(firstArg.Value);
-            value = QByteArray::fromStdString(secondArg.Value);
-        }
-        if (isList) {
-            const auto firstArg = func.Arguments()[0];
-            const auto secondArg = func.Arguments()[1];
-            const auto thirdArg = func.Arguments()[2];
-            if (firstArg.Value != "APPEND" || !isValidCMakeVariable(secondArg.Value))
-                continue;
-            key = QByteArray::fromStdString(secondArg.Value);
-            value = QByteArray::fromStdString(thirdArg.Value);
-        }
+    for (auto [key, value] : searchPathUpdates) {
         updateDirVariables(value);
         insertOrAppendListValue(key, value);
     }
 }
 
-static QPair<QStringList, QStringList> getFindAndConfigCMakePackages(
-    const CMakeConfig &cmakeCache, const Environment &environment)
-{
-    auto toFilePath = [](const QByteArray &str) -> FilePath {
-        return FilePath::fromUserInput(QString::fromUtf8(str));
-    };
-
-    auto findPackageName = [](const QString &fileName) -> QString {
-        auto findIdx = fileName.indexOf("Find");
-        auto endsWithCMakeIdx = fileName.lastIndexOf(".cmake");
-        if (findIdx == 0 && endsWithCMakeIdx > 0)
-            return fileName.mid(4, endsWithCMakeIdx - 4);
-        return QString();
-    };
-
-    auto configPackageName = [](const QString &fileName) -> QString {
-        auto configCMakeIdx = fileName.lastIndexOf("Config.cmake");
-        if (configCMakeIdx > 0)
-            return fileName.left(configCMakeIdx);
-        auto dashConfigCMakeIdx = fileName.lastIndexOf("-config.cmake");
-        if (dashConfigCMakeIdx > 0)
-            return fileName.left(dashConfigCMakeIdx);
-        return QString();
-    };
-
-    QStringList modulePackages;
-    QStringList configPackages;
-
-    struct
-    {
-        const QByteArray cmakeVariable;
-        const QString pathPrefix;
-        std::function<QString(const QString &)> function;
-        QStringList &result;
-    } mapping[] = {{"CMAKE_PREFIX_PATH", "lib/cmake", configPackageName, configPackages},
-                   {"CMAKE_PREFIX_PATH", "share", configPackageName, configPackages},
-                   {"CMAKE_MODULE_PATH", QString(), findPackageName, modulePackages},
-                   {"CMAKE_MODULE_PATH", QString(), configPackageName, configPackages}};
-
-    for (const auto &m : mapping) {
-        FilePaths paths = Utils::transform<FilePaths>(cmakeCache.valueOf(m.cmakeVariable).split(';'),
-                                                      toFilePath);
-
-        paths << Utils::transform<FilePaths>(environment.value(QString::fromUtf8(m.cmakeVariable))
-                                                 .split(";"),
-                                             &FilePath::fromUserInput);
-
-        for (const auto &prefix : paths) {
-            // Only search for directories if we have a prefix
-            const FilePaths dirs = !m.pathPrefix.isEmpty()
-                                       ? prefix.pathAppended(m.pathPrefix)
-                                             .dirEntries({{"*"}, QDir::Dirs | QDir::NoDotAndDotDot})
-                                       : FilePaths{prefix};
-            const QStringList cmakeFiles
-                = Utils::transform<QStringList>(dirs, [](const FilePath &path) {
-                      return Utils::transform(path.dirEntries({{"*.cmake"}, QDir::Files},
-                                                              QDir::Name),
-                                              &FilePath::fileName);
-                  });
-            m.result << Utils::transform(cmakeFiles, m.function);
-        }
-        m.result = Utils::filtered(m.result, std::not_fn(&QString::isEmpty));
-    }
-
-    return {modulePackages, configPackages};
-}
-
 class PerformInputData
 {
 public:
@@ -506,39 +387,73 @@ IAssistProposal *CMakeFileCompletionAssist::doPerform(const PerformInputDataPtr
         }
     }
 
-    cmListFile cmakeListFile = parseCMakeListFromBuffer(
-        interface()->textAt(0, prevFunctionEnd + 1).toUtf8());
-    auto [localFunctions, localVariables] = getLocalFunctionsAndVariables(cmakeListFile);
+    const LocalCompletionData localData
+        = CMakeFileCompletionModel::forDocument(interface()->filePath())
+              ->update(interface()->textAt(0, prevFunctionEnd + 1));
+    const QStringList &localFunctions = localData.functions;
+    const QStringList &localVariables = localData.variables;
 
     CMakeConfig cmakeConfiguration = data->cmakeConfiguration;
     const FilePath currentDir = interface()->filePath().absolutePath();
-    updateCMakeConfigurationWithLocalData(cmakeConfiguration, cmakeListFile, currentDir);
-
-    auto [findModules, configModules] = getFindAndConfigCMakePackages(cmakeConfiguration,
-                                                                      data->environment);
-
+    updateCMakeConfigurationWithLocalData(cmakeConfiguration,
+                                          localData.searchPathUpdates,
+                                          currentDir);
+
+    // Only create the items the proposal can show while the prefix grows. The keywords of the
+    // CMake tool and the symbols of the project come from prebuilt pools, the other words
+    // change with each request. The model of the proposal creates the items again from their
+    // sources if the prefix gets shorter.
+    const CMakeCompletionFilter filter(interface()->textAt(startPos,
+                                                           interface()->position() - startPos),
+                                       fuzzyCaseSensitivity());
+    QList<CMakeCompletionModel::ItemSource> sources;
+    const auto addPooled = [&sources](const auto &words, const QIcon &icon) {
+        sources.append([pool = CMakeCompletionPool::forWords(words),
+                        icon](const CMakeCompletionFilter &currentFilter,
+                              const CMakeCompletionModel::Items &) {
+            return pool->createItems(icon, currentFilter);
+        });
+    };
+    const auto addWords = [&sources](const QStringList &words, const QIcon &icon) {
+        sources.append([words, icon](const CMakeCompletionFilter &currentFilter,
+                                     const CMakeCompletionModel::Items &) {
+            return generateList(words, icon, currentFilter);
+        });
+    };
+    const auto addCacheEntries = [&sources](const CMakeConfig &cache, const QIcon &icon) {
+        sources.append([cache, icon](const CMakeCompletionFilter &currentFilter,
+                                     const CMakeCompletionModel::Items &previousItems) {
+            return generateList(cache, icon, currentFilter, previousItems);
+        });
+    };
+    // Files and snippets do not depend on the prefix
     QList<AssistProposalItemInterface *> items;
+    const auto createProposal = [&filter, &sources, &items, startPos] {
+        return new GenericProposal(startPos,
+                                   GenericProposalModelPtr(
+                                       new CMakeCompletionModel(filter, sources, items)));
+    };
 
     const QString varGenexToken = interface()->textAt(startPos - 2, 2);
     const QString varEnvironmentToken = interface()->textAt(startPos - 5, 5);
     if (varGenexToken == "${" || varGenexToken == "$<" || varEnvironmentToken == "$ENV{") {
         if (varGenexToken == "${") {
-            items.append(generateList(data->keywords.variables, m_variableIcon));
-            items.append(generateList(data->projectVariables, m_projectVariableIcon));
-            items.append(generateList(data->findPackageVariables, m_projectVariableIcon));
+            addPooled(data->keywords.variables, m_variableIcon);
+            addPooled(data->projectVariables, m_projectVariableIcon);
+            addPooled(data->findPackageVariables, m_projectVariableIcon);
         }
         if (varGenexToken == "$<")
-            items.append(generateList(data->keywords.generatorExpressions, m_genexIcon));
+            addPooled(data->keywords.generatorExpressions, m_genexIcon);
 
         if (varEnvironmentToken == "$ENV{")
-            items.append(generateList(data->keywords.environmentVariables, m_variableIcon));
+            addPooled(data->keywords.environmentVariables, m_variableIcon);
 
-        return new GenericProposal(startPos, items);
+        return createProposal();
     }
 
     const QString ifEnvironmentToken = interface()->textAt(startPos - 4, 4);
     if ((functionName == "if" || functionName == "elseif") && ifEnvironmentToken == "ENV{")
-        items.append(generateList(data->keywords.environmentVariables, m_variableIcon));
+        addPooled(data->keywords.environmentVariables, m_variableIcon);
 
     int fileStartPos = startPos;
     const auto onlyFileItems = [&] { return fileStartPos != startPos; };
@@ -546,15 +461,15 @@ IAssistProposal *CMakeFileCompletionAssist::doPerform(const PerformInputDataPtr
     if (functionName == "if" || functionName == "elseif" || functionName == "while"
         || functionName == "set" || functionName == "list"
         || functionName == "cmake_print_variables") {
-        items.append(generateList(data->keywords.variables, m_variableIcon));
-        items.append(generateList(data->projectVariables, m_projectVariableIcon));
-        items.append(generateList(data->findPackageVariables, m_projectVariableIcon));
-        items.append(generateList(localVariables, m_variableIcon));
-        items.append(generateList(cmakeConfiguration, m_variableIcon, items));
+        addPooled(data->keywords.variables, m_variableIcon);
+        addPooled(data->projectVariables, m_projectVariableIcon);
+        addPooled(data->findPackageVariables, m_projectVariableIcon);
+        addWords(localVariables, m_variableIcon);
+        addCacheEntries(cmakeConfiguration, m_variableIcon);
     }
 
     if (functionName == "if" || functionName == "elseif" || functionName == "cmake_policy")
-        items.append(generateList(data->keywords.policies, m_variableIcon));
+        addPooled(data->keywords.policies, m_variableIcon);
 
     if (functionName.contains("path") || functionName.contains("file")
         || functionName.contains("add_executable") || functionName.contains("add_library")
@@ -565,23 +480,25 @@ IAssistProposal *CMakeFileCompletionAssist::doPerform(const PerformInputDataPtr
     }
 
     if (functionName == "set_property" || functionName == "cmake_print_properties")
-        items.append(generateList(data->keywords.properties, m_propertyIcon));
+        addPooled(data->keywords.properties, m_propertyIcon);
 
     if (functionName == "set_directory_properties")
-        items.append(generateList(data->keywords.directoryProperties, m_propertyIcon));
+        addPooled(data->keywords.directoryProperties, m_propertyIcon);
     if (functionName == "set_source_files_properties")
-        items.append(generateList(data->keywords.sourceProperties, m_propertyIcon));
+        addPooled(data->keywords.sourceProperties, m_propertyIcon);
     if (functionName == "set_target_properties")
-        items.append(generateList(data->keywords.targetProperties, m_propertyIcon));
+        addPooled(data->keywords.targetProperties, m_propertyIcon);
     if (functionName == "set_tests_properties")
-        items.append(generateList(data->keywords.testProperties, m_propertyIcon));
+        addPooled(data->keywords.testProperties, m_propertyIcon);
 
     if (functionName == "include" && !onlyFileItems())
-        items.append(generateList(data->keywords.includeStandardModules, m_moduleIcon));
+        addPooled(data->keywords.includeStandardModules, m_moduleIcon);
     if (functionName == "find_package") {
-        items.append(generateList(data->keywords.findModules, m_moduleIcon));
-        items.append(generateList(findModules, m_moduleIcon));
-        items.append(generateList(configModules, m_moduleIcon));
+        const CMakePackages packages = CMakePackageIndex::packages(cmakeConfiguration,
+                                                                   data->environment);
+        addPooled(data->keywords.findModules, m_moduleIcon);
+        addPooled(packages.modulePackages, m_moduleIcon);
+        addPooled(packages.configPackages, m_moduleIcon);
     }
 
     if ((functionName.contains("target") || functionName == "install"
@@ -589,18 +506,18 @@ IAssistProposal *CMakeFileCompletionAssist::doPerform(const PerformInputDataPtr
          || functionName == "export" || functionName == "cmake_print_properties"
          || functionName == "if" || functionName == "elseif")
         && !onlyFileItems()) {
-        items.append(generateList(data->buildTargets, m_targetsIcon));
-        items.append(generateList(data->importedTargets, m_importedTargetIcon));
+        addWords(data->buildTargets, m_targetsIcon);
+        addPooled(data->importedTargets, m_importedTargetIcon);
     }
 
     if (data->keywords.functionArgs.contains(functionName) && !onlyFileItems()) {
         const QStringList functionSymbols = data->keywords.functionArgs.value(functionName);
-        items.append(generateList(functionSymbols, m_argsIcon));
+        addPooled(functionSymbols, m_argsIcon);
     } else if (functionName.isEmpty()) {
         // On a new line we just want functions
-        items.append(generateList(data->keywords.functions, m_functionIcon));
-        items.append(generateList(data->projectFunctions, m_projectFunctionIcon));
-        items.append(generateList(localFunctions, m_functionIcon));
+        addPooled(data->keywords.functions, m_functionIcon);
+        addPooled(data->projectFunctions, m_projectFunctionIcon);
+        addWords(localFunctions, m_functionIcon);
 
         // Snippets would make more sense only for the top level suggestions
         items.append(m_snippetCollector.collect());
@@ -608,19 +525,19 @@ IAssistProposal *CMakeFileCompletionAssist::doPerform(const PerformInputDataPtr
         // Inside an unknown function we could have variables or properties
         fileStartPos = addFilePathItems(interface(), items, startPos);
         if (!onlyFileItems()) {
-            items.append(generateList(data->keywords.variables, m_variableIcon));
-            items.append(generateList(data->projectVariables, m_projectVariableIcon));
-            items.append(generateList(localVariables, m_variableIcon));
-            items.append(generateList(cmakeConfiguration, m_variableIcon, items));
-            items.append(generateList(data->findPackageVariables, m_projectVariableIcon));
-
-            items.append(generateList(data->keywords.properties, m_propertyIcon));
-            items.append(generateList(data->buildTargets, m_targetsIcon));
-            items.append(generateList(data->importedTargets, m_importedTargetIcon));
+            addPooled(data->keywords.variables, m_variableIcon);
+            addPooled(data->projectVariables, m_projectVariableIcon);
+            addWords(localVariables, m_variableIcon);
+            addCacheEntries(cmakeConfiguration, m_variableIcon);
+            addPooled(data->findPackageVariables, m_projectVariableIcon);
+
+            addPooled(data->keywords.properties, m_propertyIcon);
+            addWords(data->buildTargets, m_targetsIcon);
+            addPooled(data->importedTargets, m_importedTargetIcon);
         }
     }
 
-    return new GenericProposal(startPos, items);
+    return createProposal();
 }
 
 IAssistProcessor *CMakeFileCompletionAssistProvider::createProcessor(const AssistInterface *) const
@@ -0,0 +1,113 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cmakefilecompletionmodel.h"
+
+#include "cmakelistfileview.h"
+
+#include <QHash>
+#include <QMutexLocker>
+
+#include <algorithm>
+
+using namespace Utils;
+
+namespace CMakeProjectManager::Internal {
+
+static void addLocalData(LocalCompletionData &data, const ListFileFunction &func)
+{
+    if (func.arguments.empty())
+        return;
+
+    if (func.lowerCaseName == "macro" || func.lowerCaseName == "function")
+        data.functions << func.arguments[0].toString();
+    if (func.lowerCaseName == "set" || func.lowerCaseName == "option")
+        data.variables << func.arguments[0].toString();
+
+    const auto isSearchPathVariable = [](std::string_view var) {
+        return var == "CMAKE_PREFIX_PATH" || var == "CMAKE_MODULE_PATH";
+    };
+    if (func.lowerCaseName == "set" && func.arguments.size() > 1) {
+        if (isSearchPathVariable(func.arguments[0].value)) {
+            data.searchPathUpdates.append(
+                {func.arguments[0].toByteArray(), func.arguments[1].toByteArray()});
+        }
+    } else if (func.lowerCaseName == "list" && func.arguments.size() > 2) {
+        if (func.arguments[0].value == "APPEND" && isSearchPathVariable(func.arguments[1].value)) {
+            data.searchPathUpdates.append(
+                {func.arguments[1].toByteArray(), func.arguments[2].toByteArray()});
+        }
+    }
+}
+
+LocalCompletionData CMakeFileCompletionModel::update(const QString &text)
+{
+    QMutexLocker locker(&m_mutex);
+
+    const qsizetype commonPrefix
+        = std::mismatch(m_text.cbegin(), m_text.cend(), text.cbegin(), text.cend()).first
+          - m_text.cbegin();
+
+    // A command is kept if all lines up to the next command are unchanged. The last one is
+    // always parsed again, text appended to it may belong to it.
+    qsizetype kept = 0;
+    while (kept + 1 < m_commands.size() && m_commands.at(kept + 1).lineStart <= commonPrefix)
+        ++kept;
+
+    // Commands start on a line of their own, the lexer is in its initial state there
+    const qsizetype tailStart = kept > 0 ? m_commands.at(kept).lineStart : 0;
+    const QStringView tail = QStringView(text).mid(tailStart);
+
+    m_commands.resize(kept);
+    const Command lastKept = kept > 0 ? m_commands.last() : Command();
+    m_data.functions.resize(lastKept.functionsEnd);
+    m_data.variables.resize(lastKept.variablesEnd);
+    m_data.searchPathUpdates.resize(lastKept.searchPathUpdatesEnd);
+    m_text = text;
+
+    CMakeListFileView cmakeListFile;
+    if (!tail.isEmpty() && !cmakeListFile.parse(tail.toUtf8()))
+        return {}; // Like a parse of the whole text, the kept commands are fine for the next try
+
+    QList<qsizetype> lineStarts{0};
+    for (qsizetype i = 0; i < tail.size(); ++i) {
+        if (tail.at(i) == '\n')
+            lineStarts.append(i + 1);
+    }
+
+    for (const ListFileFunction &func : cmakeListFile.functions()) {
+        addLocalData(m_data, func);
+        Command command;
+        command.lineStart = tailStart + lineStarts.value(func.line - 1, tail.size());
+        command.functionsEnd = m_data.functions.size();
+        command.variablesEnd = m_data.variables.size();
+        command.searchPathUpdatesEnd = m_data.searchPathUpdates.size();
+        m_commands.append(command);
+    }
+    return m_data;
+}
+
+std::shared_ptr<CMakeFileCompletionModel> CMakeFileCompletionModel::forDocument(
+    const FilePath &filePath)
+{
+    // Only the recently edited documents are kept
+    const int maxDocuments = 16;
+
+    static QMutex mutex;
+    static QHash<FilePath, std::shared_ptr<CMakeFileCompletionModel>> models;
+    static QList<FilePath> recentDocuments;
+
+    QMutexLocker locker(&mutex);
+    std::shared_ptr<CMakeFileCompletionModel> model = models.value(filePath);
+    if (!model) {
+        model = std::make_shared<CMakeFileCompletionModel>();
+        models.insert(filePath, model);
+    }
+    recentDocuments.removeOne(filePath);
+    recentDocuments.prepend(filePath);
+    if (recentDocuments.size() > maxDocuments)
+        models.remove(recentDocuments.takeLast());
+    return model;
+}
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,59 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+namespace CMakeProjectManager::Internal {
+
+class LocalCompletionData
+{
+public:
+    QStringList functions; // function() and macro()
+    QStringList variables; // set() and option()
+    // Values of set(CMAKE_PREFIX_PATH|CMAKE_MODULE_PATH ...) and list(APPEND ...) in order
+    QList<QPair<QByteArray, QByteArray>> searchPathUpdates;
+};
+
+// What the code completion needs from the commands in front of the cursor.
+//
+// The model remembers the text of the last request of a document. On the next request only
+// the commands from the first changed line on are parsed again, the data of the commands in
+// front of them is kept. Typing thus costs the parse of a few commands instead of the whole
+// file.
+class CMakeFileCompletionModel
+{
+public:
+    // Thread-safe, the completion runs in a worker thread
+    LocalCompletionData update(const QString &text);
+
+    static std::shared_ptr<CMakeFileCompletionModel> forDocument(const Utils::FilePath &filePath);
+
+private:
+    class Command
+    {
+    public:
+        qsizetype lineStart = 0; // Of the first line of the command in m_text
+        // Of the data up to and including this command
+        qsizetype functionsEnd = 0;
+        qsizetype variablesEnd = 0;
+        qsizetype searchPathUpdatesEnd = 0;
+    };
+
+    QMutex m_mutex;
+    QString m_text;
+    QList<Command> m_commands;
+    LocalCompletionData m_data;
+};
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,339 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cmakehelpindex.h"
+
+#include "cmaketoolmanager.h"
+
+#include <coreplugin/icore.h>
+
+#include <utils/algorithm.h>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QSet>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace Utils;
+
+namespace CMakeProjectManager::Internal {
+
+static Q_LOGGING_CATEGORY(cmakeHelpIndexLog, "qtc.cmake.helpIndex", QtWarningMsg);
+
+const quint32 INDEX_MAGIC = 0x51434849; // "QCHI"
+const quint32 INDEX_VERSION = 1;
+const quint32 INDEX_END_MARKER = 0x454e4421; // "END!"
+
+// Shorter words are not indexed
+const int minimumTermLength = 2;
+
+// The lower case words of the text. With withParts, also the parts of words like
+// CMAKE_CXX_FLAGS, so that "cxx flags" finds it.
+static QStringList splitTerms(const QString &text, bool withParts)
+{
+    QStringList terms;
+    const QString lower = text.toLower();
+    qsizetype start = -1;
+    for (qsizetype i = 0; i <= lower.size(); ++i) {
+        if (i < lower.size() && (lower.at(i).isLetterOrNumber() || lower.at(i) == '_')) {
+            if (start < 0)
+                start = i;
+            continue;
+        }
+        if (start < 0)
+            continue;
+        const QStringView word = QStringView(lower).mid(start, i - start);
+        start = -1;
+        if (word.size() < minimumTermLength)
+            continue;
+        terms.append(word.toString());
+        if (withParts && word.contains('_')) {
+            for (const QStringView part : word.split('_', Qt::SkipEmptyParts)) {
+                if (part.size() >= minimumTermLength)
+                    terms.append(part.toString());
+            }
+        }
+    }
+    return terms;
+}
+
+QList<int> CMakeHelpIndex::entriesForTerm(const QString &term, bool prefix) const
+{
+    auto it = std::lower_bound(m_terms.cbegin(), m_terms.cend(), term);
+    if (!prefix) {
+        if (it == m_terms.cend() || *it != term)
+            return {};
+        return m_postings.at(it - m_terms.cbegin());
+    }
+
+    QList<int> result;
+    for (; it != m_terms.cend() && it->startsWith(term); ++it)
+        result.append(m_postings.at(it - m_terms.cbegin()));
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+QList<const CMakeHelpIndex::Entry *> CMakeHelpIndex::search(const QString &text, int limit) const
+{
+    const QStringList terms = splitTerms(text, false);
+    if (terms.isEmpty())
+        return {};
+
+    // Sorted entry indexes that contain all terms
+    QList<int> candidates;
+    for (qsizetype i = 0; i < terms.size(); ++i) {
+        const QList<int> entries = entriesForTerm(terms.at(i), i == terms.size() - 1);
+        if (i == 0) {
+            candidates = entries;
+        } else {
+            QList<int> intersection;
+            std::set_intersection(candidates.cbegin(), candidates.cend(),
+                                  entries.cbegin(), entries.cend(),
+                                  std::back_inserter(intersection));
+            candidates = intersection;
+        }
+        if (candidates.isEmpty())
+            return {};
+    }
+
+    const QString trimmedText = text.trimmed();
+    QList<const Entry *> prefixMatches;
+    QList<const Entry *> nameMatches;
+    QList<const Entry *> otherMatches;
+    for (int index : std::as_const(candidates)) {
+        const Entry &entry = m_entries.at(index);
+        if (entry.name.startsWith(trimmedText, Qt::CaseInsensitive))
+            prefixMatches.append(&entry);
+        else if (entry.name.contains(trimmedText, Qt::CaseInsensitive))
+            nameMatches.append(&entry);
+        else
+            otherMatches.append(&entry);
+    }
+
+    QList<const Entry *> result = prefixMatches + nameMatches + otherMatches;
+    if (limit >= 0 && result.size() > limit)
+        result.resize(limit);
+    return result;
+}
+
+// --------------------------------------------------------------------
+// Loading:
+// --------------------------------------------------------------------
+
+// The help files change with the CMake installation only
+static qint64 helpFilesStamp(const FilePaths &helpFiles)
+{
+    qint64 newest = 0;
+    for (const FilePath &helpFile : helpFiles)
+        newest = qMax(newest, helpFile.lastModified().toMSecsSinceEpoch());
+    return newest;
+}
+
+static FilePath indexFile(const FilePath &helpDirectory)
+{
+    const QByteArray hash = QCryptographicHash::hash(helpDirectory.toString().toUtf8(),
+                                                     QCryptographicHash::Sha1)
+                                .toHex()
+                                .left(16);
+    return Core::ICore::cacheResourcePath("cmake-help")
+        .pathAppended(QString::fromLatin1(hash) + ".index");
+}
+
+std::shared_ptr<const CMakeHelpIndex> CMakeHelpIndex::load(const CMakeKeywords &keywords)
+{
+    // Each help file once, the global properties contain the ones of the other kinds
+    QSet<FilePath> seen;
+    FilePaths helpFiles;
+    for (const QMap<QString, FilePath> *map : {&keywords.functions,
+                                               &keywords.variables,
+                                               &keywords.properties,
+                                               &keywords.environmentVariables,
+                                               &keywords.includeStandardModules,
+                                               &keywords.findModules,
+                                               &keywords.policies}) {
+        for (const FilePath &helpFile : *map) {
+            if (!helpFile.isEmpty() && !seen.contains(helpFile)) {
+                seen.insert(helpFile);
+                helpFiles.append(helpFile);
+            }
+        }
+    }
+    if (helpFiles.isEmpty())
+        return {};
+
+    // All help files are in a directory per category of the Help directory
+    const FilePath file = indexFile(helpFiles.first().parentDir().parentDir());
+    const qint64 stamp = helpFilesStamp(helpFiles);
+
+    if (std::optional<CMakeHelpIndex> index = read(file, stamp)) {
+        if (index->m_entries.size() == helpFiles.size()
+            && Utils::allOf(helpFiles, [&index](const FilePath &helpFile) {
+                   return index->m_entryByHelpFile.contains(helpFile);
+               })) {
+            return std::make_shared<const CMakeHelpIndex>(std::move(*index));
+        }
+        qCDebug(cmakeHelpIndexLog) << "Help files changed for" << file;
+    }
+
+    Utils::sort(helpFiles, [](const FilePath &a, const FilePath &b) {
+        return a.completeBaseName().compare(b.completeBaseName(), Qt::CaseInsensitive) < 0;
+    });
+
+    auto index = std::make_shared<CMakeHelpIndex>();
+    QHash<QString, QList<int>> postings;
+    for (const FilePath &helpFile : std::as_const(helpFiles)) {
+        const QByteArray content = helpFile.fileContents().value_or(QByteArray());
+        const int entryIndex = index->m_entries.size();
+        index->m_entries.append({helpFile.completeBaseName(),
+                                 helpFile.parentDir().fileName(),
+                                 helpFile,
+                                 CMakeToolManager::toolTipForRstHelpText(content)});
+        index->m_entryByHelpFile.insert(helpFile, entryIndex);
+
+        const QStringList terms = splitTerms(helpFile.completeBaseName() + ' '
+                                                 + QString::fromUtf8(content),
+                                             true);
+        for (const QString &term : terms) {
+            QList<int> &entries = postings[term];
+            // Entries are visited in order, so this keeps the list sorted and unique
+            if (entries.isEmpty() || entries.last() != entryIndex)
+                entries.append(entryIndex);
+        }
+    }
+    index->m_terms = Utils::sorted(postings.keys());
+    index->m_postings.reserve(index->m_terms.size());
+    for (const QString &term : std::as_const(index->m_terms))
+        index->m_postings.append(postings.value(term));
+
+    index->write(file, stamp);
+    return index;
+}
+
+// --------------------------------------------------------------------
+// Registry:
+// --------------------------------------------------------------------
+
+static QMutex s_indexesMutex;
+static QHash<FilePath, std::shared_ptr<const CMakeHelpIndex>> s_indexes;
+
+void CMakeHelpIndex::setIndex(const FilePath &cmakeExecutable,
+                              const std::shared_ptr<const CMakeHelpIndex> &index)
+{
+    QMutexLocker locker(&s_indexesMutex);
+    if (index)
+        s_indexes.insert(cmakeExecutable, index);
+    else
+        s_indexes.remove(cmakeExecutable);
+}
+
+std::shared_ptr<const CMakeHelpIndex> CMakeHelpIndex::forExecutable(
+    const FilePath &cmakeExecutable)
+{
+    QMutexLocker locker(&s_indexesMutex);
+    return s_indexes.value(cmakeExecutable);
+}
+
+std::optional<QString> CMakeHelpIndex::toolTip(const FilePath &helpFile)
+{
+    QMutexLocker locker(&s_indexesMutex);
+    for (const std::shared_ptr<const CMakeHelpIndex> &index : std::as_const(s_indexes)) {
+        const auto it = index->m_entryByHelpFile.constFind(helpFile);
+        if (it != index->m_entryByHelpFile.cend())
+            return index->m_entries.at(*it).toolTip;
+    }
+    return {};
+}
+
+// --------------------------------------------------------------------
+// Storage:
+// --------------------------------------------------------------------
+
+bool CMakeHelpIndex::write(const FilePath &file, qint64 stamp) const
+{
+    // Written with QSaveFile, so it needs to be a local file
+    if (file.needsDevice() || !file.parentDir().ensureWritableDir())
+        return false;
+
+    QByteArray contents;
+    {
+        QDataStream s(&contents, QIODevice::WriteOnly);
+        s.setVersion(QDataStream::Qt_6_0);
+        s << INDEX_MAGIC << INDEX_VERSION << stamp << qint32(m_entries.size());
+        for (const Entry &entry : m_entries)
+            s << entry.name << entry.category << entry.helpFile.toString() << entry.toolTip;
+        s << m_terms << m_postings;
+        s << INDEX_END_MARKER;
+    }
+
+    QSaveFile saveFile(file.toFSPathString());
+    if (!saveFile.open(QIODevice::WriteOnly) || saveFile.write(contents) != contents.size()
+        || !saveFile.commit()) {
+        qCWarning(cmakeHelpIndexLog) << "Failed to write help index" << file;
+        return false;
+    }
+    qCDebug(cmakeHelpIndexLog) << "Wrote" << m_entries.size() << "help files and"
+                               << m_terms.size() << "words to" << file;
+    return true;
+}
+
+std::optional<CMakeHelpIndex> CMakeHelpIndex::read(const FilePath &file, qint64 stamp)
+{
+    if (file.needsDevice())
+        return {};
+    QFile input(file.toFSPathString());
+    if (!input.open(QIODevice::ReadOnly))
+        return {};
+
+    QDataStream s(&input);
+    s.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 storedStamp = 0;
+    s >> magic >> version >> storedStamp;
+    if (s.status() != QDataStream::Ok || magic != INDEX_MAGIC || version != INDEX_VERSION
+        || storedStamp != stamp) {
+        qCDebug(cmakeHelpIndexLog) << "Outdated help index" << file;
+        return {};
+    }
+
+    qint32 count = 0;
+    s >> count;
+    CMakeHelpIndex index;
+    for (qint32 i = 0; i < count && s.status() == QDataStream::Ok; ++i) {
+        Entry entry;
+        QString helpFile;
+        s >> entry.name >> entry.category >> helpFile >> entry.toolTip;
+        entry.helpFile = FilePath::fromString(helpFile);
+        index.m_entryByHelpFile.insert(entry.helpFile, i);
+        index.m_entries.append(entry);
+    }
+    s >> index.m_terms >> index.m_postings;
+
+    quint32 endMarker = 0;
+    s >> endMarker;
+    if (s.status() != QDataStream::Ok || endMarker != INDEX_END_MARKER
+        || index.m_terms.size() != index.m_postings.size()) {
+        qCWarning(cmakeHelpIndexLog) << "Broken help index" << file;
+        return {};
+    }
+    for (const QList<int> &entries : std::as_const(index.m_postings)) {
+        if (!entries.isEmpty() && (entries.first() < 0 || entries.last() >= count)) {
+            qCWarning(cmakeHelpIndexLog) << "Broken help index" << file;
+            return {};
+        }
+    }
+
+    qCDebug(cmakeHelpIndexLog) << "Read" << count << "help files from" << file;
+    return index;
+}
+
+} // CMakeProjectManager::Internal
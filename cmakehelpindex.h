@@ -0,0 +1,73 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include "cmaketool.h"
+
+#include <utils/filepath.h>
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <optional>
+
+namespace CMakeProjectManager::Internal {
+
+// The help files of the keywords of a CMake installation, with the rendered tooltips and an
+// index of the words in the files.
+//
+// The index is built in the background when the keywords of a CMake tool are loaded, and
+// stored in the cache directory until the help files change. Tooltips and searches do not
+// touch the help files.
+class CMakeHelpIndex
+{
+public:
+    class Entry
+    {
+    public:
+        QString name;             // Like "add_library" or "CMAKE_CXX_FLAGS"
+        QString category;         // The directory of the documentation, like "command"
+        Utils::FilePath helpFile;
+        QString toolTip;          // Markdown
+
+        // The page of the entry, relative to the documentation URL of the tool
+        QString helpUrl() const { return QString("%1/%2.html").arg(category, name); }
+    };
+
+    CMakeHelpIndex() = default;
+
+    bool isEmpty() const { return m_entries.isEmpty(); }
+    const QList<Entry> &entries() const { return m_entries; }
+
+    // Entries whose help files contain all words of the text, the last word can be the start
+    // of a word. Entries whose name contains the text come first.
+    QList<const Entry *> search(const QString &text, int limit = -1) const;
+
+    // Reads the stored index of the help files of the keywords, builds and stores it if they
+    // changed. Runs in the background.
+    static std::shared_ptr<const CMakeHelpIndex> load(const CMakeKeywords &keywords);
+
+    // The indexes of the registered CMake tools
+    static void setIndex(const Utils::FilePath &cmakeExecutable,
+                         const std::shared_ptr<const CMakeHelpIndex> &index);
+    static std::shared_ptr<const CMakeHelpIndex> forExecutable(
+        const Utils::FilePath &cmakeExecutable);
+    static std::optional<QString> toolTip(const Utils::FilePath &helpFile);
+
+private:
+    QList<int> entriesForTerm(const QString &term, bool prefix) const;
+
+    bool write(const Utils::FilePath &file, qint64 stamp) const;
+    static std::optional<CMakeHelpIndex> read(const Utils::FilePath &file, qint64 stamp);
+
+    QList<Entry> m_entries;            // Sorted by name, ignoring case
+    QHash<Utils::FilePath, int> m_entryByHelpFile;
+    QStringList m_terms;               // Lower case words of the help files, sorted
+    QList<QList<int>> m_postings;      // Of m_terms, sorted entry indexes
+};
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,317 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cmakelistfileview.h"
+
+#include "3rdparty/cmake/cmListFileLexer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+
+namespace CMakeProjectManager::Internal {
+
+static_assert(std::is_trivially_destructible_v<ListFileArgument>,
+              "The arena never runs destructors.");
+
+// --------------------------------------------------------------------
+// Arena:
+// --------------------------------------------------------------------
+
+class CMakeListFileView::Arena
+{
+public:
+    std::string_view copy(std::string_view value)
+    {
+        if (value.empty())
+            return {};
+        auto data = static_cast<char *>(allocate(value.size(), 1));
+        std::memcpy(data, value.data(), value.size());
+        return {data, value.size()};
+    }
+
+    ListFileArguments copy(const std::vector<ListFileArgument> &arguments)
+    {
+        if (arguments.empty())
+            return {};
+        auto data = static_cast<ListFileArgument *>(
+            allocate(arguments.size() * sizeof(ListFileArgument), alignof(ListFileArgument)));
+        std::uninitialized_copy(arguments.begin(), arguments.end(), data);
+        return {data, arguments.size()};
+    }
+
+private:
+    static size_t padding(const char *p, size_t alignment)
+    {
+        return (alignment - reinterpret_cast<std::uintptr_t>(p) % alignment) % alignment;
+    }
+
+    void *allocate(size_t size, size_t alignment)
+    {
+        if (!m_current || padding(m_current, alignment) + size > m_left) {
+            const size_t blockSize = std::max(m_nextBlockSize, size + alignment);
+            m_blocks.emplace_back(new char[blockSize]);
+            m_current = m_blocks.back().get();
+            m_left = blockSize;
+            m_nextBlockSize = std::min<size_t>(m_nextBlockSize * 2, 1024 * 1024);
+        }
+        char *result = m_current + padding(m_current, alignment);
+        m_left -= result + size - m_current;
+        m_current = result + size;
+        return result;
+    }
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char *m_current = nullptr;
+    size_t m_left = 0;
+    size_t m_nextBlockSize = 4096;
+};
+
+// --------------------------------------------------------------------
+// Parser:
+// --------------------------------------------------------------------
+
+// Same grammar and messages as cmListFileParser in 3rdparty/cmake/cmListFileCache.cxx.
+class CMakeListFileView::Parser
+{
+public:
+    Parser(CMakeListFileView &view, QString &error)
+        : m_view(view)
+        , m_source(view.m_contents.constData(), size_t(view.m_contents.size()))
+        , m_lexer(cmListFileLexer_New())
+        , m_error(error)
+    {}
+
+    ~Parser() { cmListFileLexer_Delete(m_lexer); }
+
+    bool parse()
+    {
+        if (!cmListFileLexer_SetString(m_lexer, m_source.data(), int(m_source.size()))) {
+            issueError("cmListFileCache: cannot allocate buffer.");
+            return false;
+        }
+
+        bool haveNewline = true;
+        while (cmListFileLexer_Token *token = cmListFileLexer_Scan(m_lexer)) {
+            if (token->type == cmListFileLexer_Token_Space) {
+            } else if (token->type == cmListFileLexer_Token_Newline) {
+                haveNewline = true;
+            } else if (token->type == cmListFileLexer_Token_CommentBracket) {
+                haveNewline = false;
+            } else if (token->type == cmListFileLexer_Token_Identifier) {
+                if (!haveNewline) {
+                    issueError(token, "Parse error.  Expected a newline, got %1 with text \"%2\".");
+                    return false;
+                }
+                haveNewline = false;
+                if (!parseFunction(token))
+                    return false;
+            } else {
+                issueError(token, "Parse error.  Expected a command name, got %1 with text \"%2\".");
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    enum Separation { SeparationOkay, SeparationWarning, SeparationError };
+
+    bool parseFunction(cmListFileLexer_Token *nameToken)
+    {
+        ListFileFunction function;
+        function.originalName = text(nameToken);
+        function.lowerCaseName = lowerCaseName(function.originalName);
+        function.line = nameToken->line;
+        m_arguments.clear();
+
+        cmListFileLexer_Token *token;
+        while ((token = cmListFileLexer_Scan(m_lexer)) && token->type == cmListFileLexer_Token_Space) {
+        }
+        if (!token) {
+            issueError("Unexpected end of file.\nParse error.  Function missing opening \"(\".");
+            return false;
+        }
+        if (token->type != cmListFileLexer_Token_ParenLeft) {
+            issueError(token, "Parse error.  Expected \"(\", got %1 with text \"%2\".");
+            return false;
+        }
+
+        unsigned long parenDepth = 0;
+        m_separation = SeparationOkay;
+        while ((token = cmListFileLexer_Scan(m_lexer))) {
+            switch (token->type) {
+            case cmListFileLexer_Token_Space:
+            case cmListFileLexer_Token_Newline:
+                m_separation = SeparationOkay;
+                continue;
+            case cmListFileLexer_Token_ParenLeft:
+                ++parenDepth;
+                m_separation = SeparationOkay;
+                if (!addArgument(token, cmListFileArgument::Unquoted))
+                    return false;
+                break;
+            case cmListFileLexer_Token_ParenRight:
+                if (parenDepth == 0) {
+                    function.lineEnd = token->line;
+                    function.arguments = m_view.m_arena->copy(m_arguments);
+                    m_view.m_functions.push_back(function);
+                    return true;
+                }
+                --parenDepth;
+                m_separation = SeparationOkay;
+                if (!addArgument(token, cmListFileArgument::Unquoted))
+                    return false;
+                m_separation = SeparationWarning;
+                break;
+            case cmListFileLexer_Token_Identifier:
+            case cmListFileLexer_Token_ArgumentUnquoted:
+                if (!addArgument(token, cmListFileArgument::Unquoted))
+                    return false;
+                m_separation = SeparationWarning;
+                break;
+            case cmListFileLexer_Token_ArgumentQuoted:
+                if (!addArgument(token, cmListFileArgument::Quoted))
+                    return false;
+                m_separation = SeparationWarning;
+                break;
+            case cmListFileLexer_Token_ArgumentBracket:
+                if (!addArgument(token, cmListFileArgument::Bracket))
+                    return false;
+                m_separation = SeparationError;
+                break;
+            case cmListFileLexer_Token_CommentBracket:
+                m_separation = SeparationError;
+                break;
+            default:
+                issueError(token, "Parse error.  Function missing ending \")\".  "
+                                  "Instead found %1 with text \"%2\".");
+                return false;
+            }
+        }
+
+        issueError("Parse error.  Function missing ending \")\".  End of file reached.");
+        return false;
+    }
+
+    bool addArgument(cmListFileLexer_Token *token, cmListFileArgument::Delimiter delimiter)
+    {
+        m_arguments.push_back({text(token), delimiter, token->line, token->column});
+        if (m_separation == SeparationOkay)
+            return true;
+
+        const bool isError = m_separation == SeparationError
+                             || delimiter == cmListFileArgument::Bracket;
+        if (!isError)
+            return true;
+        issueError(QString("Syntax Error in cmake code at column %1\n"
+                           "Argument not separated from preceding token by whitespace.")
+                       .arg(token->column));
+        return false;
+    }
+
+    // Offset of the token text in the source. The lexer strips the delimiters of quoted and
+    // bracket arguments and the first newline of a bracket argument.
+    size_t sourceOffset(const cmListFileLexer_Token *token)
+    {
+        while (m_line < token->line) {
+            const size_t newline = m_source.find('\n', m_lineStart);
+            if (newline == std::string_view::npos)
+                return std::string_view::npos;
+            m_lineStart = newline + 1;
+            ++m_line;
+        }
+
+        size_t offset = m_lineStart + size_t(token->column) - 1;
+        if (token->type == cmListFileLexer_Token_ArgumentQuoted) {
+            ++offset;
+        } else if (token->type == cmListFileLexer_Token_ArgumentBracket) {
+            offset = m_source.find('[', offset + 1);
+            if (offset == std::string_view::npos)
+                return offset;
+            ++offset;
+            if (offset < m_source.size() && m_source[offset] == '\n')
+                ++offset;
+        }
+        return offset;
+    }
+
+    // A view into the source if the token text is unchanged there, a copy otherwise.
+    std::string_view text(const cmListFileLexer_Token *token)
+    {
+        const std::string_view value(token->text ? token->text : "", size_t(token->length));
+        const size_t offset = sourceOffset(token);
+        if (offset <= m_source.size() && m_source.substr(offset, value.size()) == value)
+            return m_source.substr(offset, value.size());
+        return m_view.m_arena->copy(value);
+    }
+
+    std::string_view lowerCaseName(std::string_view name)
+    {
+        const auto isUpper = [](char c) { return c >= 'A' && c <= 'Z'; };
+        if (std::none_of(name.begin(), name.end(), isUpper))
+            return name;
+
+        m_lowerCaseBuffer.assign(name);
+        std::transform(m_lowerCaseBuffer.begin(), m_lowerCaseBuffer.end(),
+                       m_lowerCaseBuffer.begin(),
+                       [&isUpper](char c) { return isUpper(c) ? char(c - 'A' + 'a') : c; });
+        const auto it = m_lowerCaseNames.find(m_lowerCaseBuffer);
+        if (it != m_lowerCaseNames.end())
+            return *it;
+        return *m_lowerCaseNames.insert(m_view.m_arena->copy(m_lowerCaseBuffer)).first;
+    }
+
+    void issueError(const QString &text)
+    {
+        m_error += text;
+        m_error += '\n';
+    }
+
+    void issueError(const cmListFileLexer_Token *token, const QString &format)
+    {
+        issueError(format.arg(QString::fromUtf8(cmListFileLexer_GetTypeAsString(m_lexer,
+                                                                                 token->type)),
+                              QString::fromUtf8(token->text ? token->text : "")));
+    }
+
+    CMakeListFileView &m_view;
+    const std::string_view m_source;
+    cmListFileLexer *m_lexer = nullptr;
+    QString &m_error;
+
+    Separation m_separation = SeparationOkay;
+    std::vector<ListFileArgument> m_arguments; // Of the current function, reused
+    std::string m_lowerCaseBuffer;
+    std::unordered_set<std::string_view> m_lowerCaseNames;
+
+    int m_line = 1;
+    size_t m_lineStart = 0;
+};
+
+// --------------------------------------------------------------------
+// CMakeListFileView:
+// --------------------------------------------------------------------
+
+CMakeListFileView::CMakeListFileView() = default;
+CMakeListFileView::~CMakeListFileView() = default;
+CMakeListFileView::CMakeListFileView(CMakeListFileView &&other) noexcept = default;
+CMakeListFileView &CMakeListFileView::operator=(CMakeListFileView &&other) noexcept = default;
+
+bool CMakeListFileView::parse(const QByteArray &contents, QString *errorMessage)
+{
+    m_contents = contents;
+    m_arena = std::make_unique<Arena>();
+    m_functions.clear();
+
+    QString error;
+    const bool ok = Parser(*this, error).parse();
+    if (errorMessage)
+        *errorMessage = error;
+    return ok;
+}
+
+} // CMakeProjectManager::Internal
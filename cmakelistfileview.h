@@ -0,0 +1,89 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include "3rdparty/cmake/cmListFileCache.h"
+
+#include <QByteArray>
+#include <QString>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace CMakeProjectManager::Internal {
+
+class ListFileArgument
+{
+public:
+    QString toString() const { return QString::fromUtf8(value.data(), qsizetype(value.size())); }
+    QByteArray toByteArray() const { return QByteArray(value.data(), qsizetype(value.size())); }
+
+    std::string_view value;
+    cmListFileArgument::Delimiter delimiter = cmListFileArgument::Unquoted;
+    int line = 0;
+    int column = 0;
+};
+
+class ListFileArguments
+{
+public:
+    ListFileArguments() = default;
+    ListFileArguments(const ListFileArgument *begin, size_t size)
+        : m_begin(begin), m_size(size)
+    {}
+
+    const ListFileArgument *begin() const { return m_begin; }
+    const ListFileArgument *end() const { return m_begin + m_size; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const ListFileArgument &operator[](size_t i) const { return m_begin[i]; }
+
+private:
+    const ListFileArgument *m_begin = nullptr;
+    size_t m_size = 0;
+};
+
+class ListFileFunction
+{
+public:
+    std::string_view originalName;
+    std::string_view lowerCaseName;
+    int line = 0;
+    int lineEnd = 0;
+    ListFileArguments arguments;
+};
+
+// A parsed CMake file for code that only reads the commands, like the editor and the code
+// completion.
+//
+// In contrast to cmListFile the names and argument values are views into the parsed buffer,
+// which the view keeps alive. Values the lexer had to rewrite (quoted arguments with line
+// continuations), the argument arrays and the lower case names that differ from the original
+// ones go to an arena owned by the view. Parsing a file thus costs a few allocations instead
+// of some per command and argument.
+//
+// Views are only valid as long as the CMakeListFileView they came from.
+class CMakeListFileView
+{
+public:
+    CMakeListFileView();
+    ~CMakeListFileView();
+    CMakeListFileView(CMakeListFileView &&other) noexcept;
+    CMakeListFileView &operator=(CMakeListFileView &&other) noexcept;
+
+    bool parse(const QByteArray &contents, QString *errorMessage = nullptr);
+
+    const std::vector<ListFileFunction> &functions() const { return m_functions; }
+
+private:
+    class Arena;
+    class Parser;
+
+    QByteArray m_contents;
+    std::unique_ptr<Arena> m_arena;
+    std::vector<ListFileFunction> m_functions;
+};
+
+} // CMakeProjectManager::Internal
@@ -5,8 +5,12 @@
 
 #include "cmakebuildstep.h"
 #include "cmakebuildsystem.h"
+#include "cmakehelpindex.h"
 #include "cmakeproject.h"
 #include "cmakeprojectmanagertr.h"
+#include "cmakesymbolindex.h"
+#include "cmaketool.h"
+#include "cmaketoolmanager.h"
 
 #include <projectexplorer/buildmanager.h>
 #include <projectexplorer/buildsteplist.h>
@@ -155,4 +159,148 @@ Core::LocatorMatcherTasks CMakeOpenTargetFilter::matchers()
     return cmakeMatchers({});
 }
 
+// --------------------------------------------------------------------
+// CMakeSymbolFilter:
+// --------------------------------------------------------------------
+
+CMakeSymbolFilter::CMakeSymbolFilter()
+{
+    setId("CMake symbols");
+    setDisplayName(Tr::tr("CMake Symbols"));
+    setDescription(Tr::tr("Locates functions, macros, options, variables and targets defined "
+                          "in the CMake files of any open CMake project."));
+    setDefaultShortcutString("cms");
+    setPriority(Medium);
+    setupFilter(this);
+}
+
+static LocatorFilterEntry symbolEntry(const CMakeSymbolIndex::Entry &symbol)
+{
+    LocatorFilterEntry entry;
+    entry.displayName = symbol.name;
+    entry.linkForEditor = symbol.link;
+    entry.extraInfo = CMakeSymbolIndex::kindDisplayName(symbol.kind) + " - "
+                      + symbol.link.targetFilePath.shortNativePath();
+    entry.filePath = symbol.link.targetFilePath;
+    return entry;
+}
+
+Core::LocatorMatcherTasks CMakeSymbolFilter::matchers()
+{
+    using namespace Tasking;
+
+    Storage<LocatorStorage> storage;
+
+    const auto onSetup = [storage] {
+        const QString input = storage->input();
+        if (input.isEmpty())
+            return;
+
+        // The index of the last parse, or the stored one while the project is still parsing
+        QList<std::shared_ptr<const CMakeSymbolIndex>> indexes;
+        for (Project *project : ProjectManager::projects()) {
+            const auto cmakeProject = qobject_cast<const CMakeProject *>(project);
+            if (!cmakeProject || !cmakeProject->activeTarget())
+                continue;
+            const auto bs = qobject_cast<CMakeBuildSystem *>(
+                cmakeProject->activeTarget()->buildSystem());
+            if (!bs)
+                continue;
+            if (const std::shared_ptr<const CMakeSymbolIndex> index = bs->symbolIndex())
+                indexes.append(index);
+        }
+
+        LocatorFilterEntries entries;
+        for (const std::shared_ptr<const CMakeSymbolIndex> &index : std::as_const(indexes)) {
+            const QList<const CMakeSymbolIndex::Entry *> symbols = index->search(input);
+            for (const CMakeSymbolIndex::Entry *symbol : symbols) {
+                LocatorFilterEntry entry = symbolEntry(*symbol);
+                entry.highlightInfo = {int(symbol->name.indexOf(input, 0, Qt::CaseInsensitive)),
+                                       int(input.length())};
+                entries.append(entry);
+            }
+        }
+
+        // Nothing contains the input as is, try the fuzzy match of the other filters
+        if (entries.isEmpty()) {
+            const QRegularExpression regExp = ILocatorFilter::createRegExp(input,
+                                                                           Qt::CaseInsensitive);
+            if (!regExp.isValid())
+                return;
+            for (const std::shared_ptr<const CMakeSymbolIndex> &index : std::as_const(indexes)) {
+                for (const CMakeSymbolIndex::Entry &symbol : index->entries()) {
+                    const QRegularExpressionMatch match = regExp.match(symbol.name);
+                    if (!match.hasMatch())
+                        continue;
+                    LocatorFilterEntry entry = symbolEntry(symbol);
+                    entry.highlightInfo = ILocatorFilter::highlightInfo(match);
+                    entries.append(entry);
+                }
+            }
+        }
+        storage->reportOutput(entries);
+    };
+    return {{Sync(onSetup), storage}};
+}
+
+// --------------------------------------------------------------------
+// CMakeHelpFilter:
+// --------------------------------------------------------------------
+
+CMakeHelpFilter::CMakeHelpFilter()
+{
+    setId("CMake documentation");
+    setDisplayName(Tr::tr("CMake Documentation"));
+    setDescription(Tr::tr("Searches the documentation of the commands, variables, properties, "
+                          "modules and policies of the CMake tool of the current project."));
+    setDefaultShortcutString("cmd");
+    setPriority(Low);
+    setupFilter(this);
+}
+
+Core::LocatorMatcherTasks CMakeHelpFilter::matchers()
+{
+    using namespace Tasking;
+
+    Storage<LocatorStorage> storage;
+
+    const auto onSetup = [storage] {
+        const QString input = storage->input();
+        if (input.isEmpty())
+            return;
+
+        CMakeTool *tool = CMakeToolManager::defaultProjectOrDefaultCMakeTool();
+        if (!tool)
+            return;
+        const FilePath cmakeExecutable = tool->cmakeExecutable();
+        const std::shared_ptr<const CMakeHelpIndex> index = CMakeHelpIndex::forExecutable(
+            cmakeExecutable);
+        if (!index) {
+            // The index comes with the keywords
+            tool->warmUpKeywords();
+            return;
+        }
+
+        LocatorFilterEntries entries;
+        const QList<const CMakeHelpIndex::Entry *> helpEntries = index->search(input, 200);
+        for (const CMakeHelpIndex::Entry *helpEntry : helpEntries) {
+            LocatorFilterEntry entry;
+            entry.displayName = helpEntry->name;
+            entry.extraInfo = helpEntry->category;
+            const qsizetype position = helpEntry->name.indexOf(input, 0, Qt::CaseInsensitive);
+            if (position >= 0)
+                entry.highlightInfo = {int(position), int(input.length())};
+            const QString helpUrl = "%1/" + helpEntry->helpUrl();
+            entry.acceptor = [cmakeExecutable, helpUrl] {
+                CMakeTool::openCMakeHelpUrl(CMakeToolManager::findByCommand(cmakeExecutable),
+                                            helpUrl);
+                return AcceptResult();
+            };
+            entries.append(entry);
+        }
+        storage->reportOutput(entries);
+    };
+    return {{Sync(onSetup), storage}};
+}
+
 } // namespace CMakeProjectManager::Internal
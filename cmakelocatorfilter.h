@@ -25,4 +25,22 @@ private:
     Core::LocatorMatcherTasks matchers() final;
 };
 
+class CMakeSymbolFilter : Core::ILocatorFilter
+{
+public:
+    CMakeSymbolFilter();
+
+private:
+    Core::LocatorMatcherTasks matchers() final;
+};
+
+class CMakeHelpFilter : Core::ILocatorFilter
+{
+public:
+    CMakeHelpFilter();
+
+private:
+    Core::LocatorMatcherTasks matchers() final;
+};
+
 } // namespace CMakeProjectManager::Internal
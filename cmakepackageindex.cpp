@@ -0,0 +1,271 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cmakepackageindex.h"
+
+#include <extensionsystem/pluginmanager.h>
+
+#include <projectexplorer/projectexplorer.h>
+
+#include <utils/algorithm.h>
+#include <utils/async.h>
+#include <utils/qtcassert.h>
+
+#include <QCoreApplication>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QMutexLocker>
+
+using namespace ProjectExplorer;
+using namespace Utils;
+
+namespace CMakeProjectManager::Internal {
+
+static Q_LOGGING_CATEGORY(cmakePackageIndexLog, "qtc.cmake.packageindex", QtWarningMsg);
+
+// The directories find_package() looks into, see the "Config Mode Search Procedure" of the
+// CMake documentation for the parts supported here
+class SearchRoots
+{
+public:
+    FilePaths configRoots; // Contain a directory per package
+    FilePaths moduleDirs;  // Contain the files of the packages
+    // Of configRoots and moduleDirs, the topmost directory that is watched in place of a
+    // root that does not exist: the prefix of a config root, the parent of a module directory
+    FilePaths watchLimits;
+
+    QString key() const
+    {
+        return Utils::transform(configRoots + moduleDirs, &FilePath::toString).join('\n');
+    }
+};
+
+static SearchRoots searchRoots(const CMakeConfig &cmakeCache, const Environment &environment)
+{
+    const auto paths = [&](const QByteArray &cmakeVariable) {
+        const QStringList values = QString::fromUtf8(cmakeCache.valueOf(cmakeVariable)).split(';')
+                                   + environment.value(QString::fromUtf8(cmakeVariable)).split(';');
+        FilePaths result;
+        for (const QString &value : values) {
+            const FilePath path = FilePath::fromUserInput(value);
+            if (!path.isEmpty() && !result.contains(path))
+                result << path;
+        }
+        return result;
+    };
+
+    SearchRoots roots;
+    for (const FilePath &prefix : paths("CMAKE_PREFIX_PATH")) {
+        roots.configRoots << prefix.pathAppended("lib/cmake") << prefix.pathAppended("share");
+        roots.watchLimits << prefix << prefix;
+    }
+    roots.moduleDirs = paths("CMAKE_MODULE_PATH");
+    for (const FilePath &dir : std::as_const(roots.moduleDirs))
+        roots.watchLimits << dir.parentDir();
+    return roots;
+}
+
+static QString modulePackageName(const QString &fileName)
+{
+    if (fileName.startsWith("Find") && fileName.endsWith(".cmake"))
+        return fileName.mid(4, fileName.size() - 4 - 6);
+    return {};
+}
+
+static QString configPackageName(const QString &fileName)
+{
+    const qsizetype configCMakeIdx = fileName.lastIndexOf("Config.cmake");
+    if (configCMakeIdx > 0)
+        return fileName.left(configCMakeIdx);
+    const qsizetype dashConfigCMakeIdx = fileName.lastIndexOf("-config.cmake");
+    if (dashConfigCMakeIdx > 0)
+        return fileName.left(dashConfigCMakeIdx);
+    return {};
+}
+
+static CMakePackages scan(const SearchRoots &roots)
+{
+    const auto cmakeFiles = [](const FilePath &dir) {
+        return Utils::transform<QStringList>(dir.dirEntries({{"*.cmake"}, QDir::Files}, QDir::Name),
+                                             &FilePath::fileName);
+    };
+
+    CMakePackages packages;
+    for (const FilePath &root : roots.configRoots) {
+        for (const FilePath &dir : root.dirEntries({{"*"}, QDir::Dirs | QDir::NoDotAndDotDot})) {
+            for (const QString &fileName : cmakeFiles(dir)) {
+                const QString name = configPackageName(fileName);
+                if (!name.isEmpty())
+                    packages.configPackages << name;
+            }
+        }
+    }
+    for (const FilePath &dir : roots.moduleDirs) {
+        for (const QString &fileName : cmakeFiles(dir)) {
+            const QString moduleName = modulePackageName(fileName);
+            if (!moduleName.isEmpty())
+                packages.modulePackages << moduleName;
+            const QString configName = configPackageName(fileName);
+            if (!configName.isEmpty())
+                packages.configPackages << configName;
+        }
+    }
+    return packages;
+}
+
+// The directory that is watched for a root: the root, or while it does not exist, its
+// closest existing parent up to the limit. Empty if there is none.
+static FilePath watchedDirectory(const FilePath &root, const FilePath &limit)
+{
+    for (FilePath directory = root; !directory.isEmpty(); directory = directory.parentDir()) {
+        if (directory.isDir())
+            return directory;
+        if (directory == limit || directory.parentDir() == directory)
+            break;
+    }
+    return {};
+}
+
+class CMakePackageIndexState
+{
+public:
+    QMutex m_mutex;
+    QHash<QString, CMakePackages> m_packages; // Per search paths
+    quint64 m_generation = 0;                 // Counts the directory changes
+    CMakePackageIndex *m_index = nullptr;     // Only used in the main thread
+};
+
+static QMutex s_stateMutex;
+static std::shared_ptr<CMakePackageIndexState> s_state;
+
+static std::shared_ptr<CMakePackageIndexState> currentState()
+{
+    QMutexLocker locker(&s_stateMutex);
+    return s_state;
+}
+
+CMakePackageIndex::CMakePackageIndex()
+    : m_state(std::make_shared<CMakePackageIndexState>())
+{
+    m_state->m_index = this;
+    {
+        QMutexLocker locker(&s_stateMutex);
+        QTC_CHECK(!s_state);
+        s_state = m_state;
+    }
+    connect(&m_watcher, &FileSystemWatcher::directoryChanged,
+            this, &CMakePackageIndex::directoryChanged);
+}
+
+CMakePackageIndex::~CMakePackageIndex()
+{
+    {
+        QMutexLocker locker(&s_stateMutex);
+        s_state.reset();
+    }
+    m_state->m_index = nullptr;
+}
+
+CMakePackages CMakePackageIndex::packages(const CMakeConfig &cmakeCache,
+                                          const Environment &environment)
+{
+    const SearchRoots roots = searchRoots(cmakeCache, environment);
+    const std::shared_ptr<CMakePackageIndexState> state = currentState();
+    if (!state)
+        return scan(roots);
+
+    const QString key = roots.key();
+    quint64 generation = 0;
+    {
+        QMutexLocker locker(&state->m_mutex);
+        const auto it = state->m_packages.constFind(key);
+        if (it != state->m_packages.cend())
+            return *it;
+        generation = state->m_generation;
+    }
+
+    const CMakePackages packages = scan(roots);
+
+    // Only local directories can be watched, remote roots are walked on every call. A root
+    // that does not exist is watched through its closest existing parent, up to its prefix.
+    // The packages are not kept if there is none, the root could appear unnoticed.
+    const FilePaths allRoots = roots.configRoots + roots.moduleDirs;
+    if (Utils::anyOf(allRoots, &FilePath::needsDevice))
+        return packages;
+    FilePaths directories;
+    for (qsizetype i = 0; i < allRoots.size(); ++i) {
+        const FilePath directory = watchedDirectory(allRoots.at(i), roots.watchLimits.at(i));
+        if (directory.isEmpty())
+            return packages;
+        if (!directories.contains(directory))
+            directories << directory;
+    }
+    QMetaObject::invokeMethod(
+        qApp,
+        [state, key, packages, directories, generation] {
+            if (state->m_index)
+                state->m_index->insert(key, packages, directories, generation);
+        },
+        Qt::QueuedConnection);
+    return packages;
+}
+
+void CMakePackageIndex::prefetch(const CMakeConfig &cmakeCache, const Environment &environment)
+{
+    if (!currentState())
+        return;
+    const QFuture<void> future = Utils::asyncRun(ProjectExplorerPlugin::sharedThreadPool(),
+                                                 [cmakeCache, environment] {
+                                                     packages(cmakeCache, environment);
+                                                 });
+    ExtensionSystem::PluginManager::futureSynchronizer()->addFuture(future);
+}
+
+void CMakePackageIndex::insert(const QString &key,
+                               const CMakePackages &packages,
+                               const FilePaths &directories,
+                               quint64 generation)
+{
+    QMutexLocker locker(&m_state->m_mutex);
+    // A directory changed while it was walked
+    if (generation != m_state->m_generation || m_state->m_packages.contains(key))
+        return;
+
+    const QStringList paths = Utils::transform<QStringList>(directories, &FilePath::path);
+    for (const QString &path : paths) {
+        if (!m_watcher.watchesDirectory(path))
+            m_watcher.addDirectory(path, FileSystemWatcher::WatchAllChanges);
+        m_keys[path].append(key);
+    }
+    m_directories.insert(key, paths);
+    m_state->m_packages.insert(key, packages);
+    qCDebug(cmakePackageIndexLog) << "Indexed" << packages.modulePackages.size() << "modules and"
+                                  << packages.configPackages.size() << "config packages in"
+                                  << paths;
+}
+
+void CMakePackageIndex::directoryChanged(const QString &directory)
+{
+    QMutexLocker locker(&m_state->m_mutex);
+    ++m_state->m_generation;
+
+    const QStringList keys = m_keys.take(directory);
+    for (const QString &key : keys) {
+        m_state->m_packages.remove(key);
+        for (const QString &path : m_directories.take(key)) {
+            if (path == directory)
+                continue;
+            QStringList &pathKeys = m_keys[path];
+            pathKeys.removeAll(key);
+            if (pathKeys.isEmpty()) {
+                m_keys.remove(path);
+                m_watcher.removeDirectory(path);
+            }
+        }
+    }
+    if (m_watcher.watchesDirectory(directory))
+        m_watcher.removeDirectory(directory);
+    qCDebug(cmakePackageIndexLog) << "Dropped" << keys.size() << "indexes for" << directory;
+}
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,61 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include "cmakeconfigitem.h"
+
+#include <utils/environment.h>
+#include <utils/filepath.h>
+#include <utils/filesystemwatcher.h>
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+
+#include <memory>
+
+namespace CMakeProjectManager::Internal {
+
+class CMakePackages
+{
+public:
+    QStringList modulePackages; // Find<Package>.cmake
+    QStringList configPackages; // <Package>Config.cmake and <package>-config.cmake
+};
+
+class CMakePackageIndexState;
+
+// The packages find_package() can find in CMAKE_PREFIX_PATH and CMAKE_MODULE_PATH, from the
+// CMake cache and the environment.
+//
+// Walking the search paths takes long for big prefixes, so the result is kept per set of
+// search paths until one of the searched directories changes. The index is owned by the
+// plugin, without it the search paths are walked on every call.
+class CMakePackageIndex : public QObject
+{
+public:
+    CMakePackageIndex();
+    ~CMakePackageIndex() override;
+
+    // Thread-safe, walks the search paths on the first call for them
+    static CMakePackages packages(const CMakeConfig &cmakeCache,
+                                  const Utils::Environment &environment);
+    // Walks the search paths in the background, if they are not indexed yet
+    static void prefetch(const CMakeConfig &cmakeCache, const Utils::Environment &environment);
+
+private:
+    void insert(const QString &key,
+                const CMakePackages &packages,
+                const Utils::FilePaths &directories,
+                quint64 generation);
+    void directoryChanged(const QString &directory);
+
+    // Shared with the threads that walk the search paths, it outlives the index if needed
+    std::shared_ptr<CMakePackageIndexState> m_state;
+    QHash<QString, QStringList> m_directories;   // Watched per search paths
+    QHash<QString, QStringList> m_keys;          // Search paths per watched directory
+    Utils::FileSystemWatcher m_watcher;
+};
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,121 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cmakeparsetimings.h"
+
+#include "cmakeprojectmanagertr.h"
+
+#include <utils/algorithm.h>
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+namespace CMakeProjectManager::Internal {
+
+// --------------------------------------------------------------------
+// ParseTimings::Phase:
+// --------------------------------------------------------------------
+
+ParseTimings::Phase::Phase(ParseTimings *timings, const QString &name)
+    : m_timings(timings)
+    , m_name(name)
+{
+    if (m_timings)
+        m_start = m_timings->elapsedNs();
+}
+
+ParseTimings::Phase::~Phase()
+{
+    if (m_timings)
+        m_timings->record(m_name, m_start, m_timings->elapsedNs() - m_start, m_count);
+}
+
+// --------------------------------------------------------------------
+// ParseTimings:
+// --------------------------------------------------------------------
+
+ParseTimings::ParseTimings()
+{
+    m_timer.start();
+}
+
+qint64 ParseTimings::elapsedNs() const
+{
+    return m_timer.nsecsElapsed();
+}
+
+void ParseTimings::record(const QString &name, qint64 startNs, qint64 durationNs, qsizetype count)
+{
+    const quint64 threadId = quint64(quintptr(QThread::currentThreadId()));
+
+    QMutexLocker locker(&m_mutex);
+    m_entries.append({name, startNs, durationNs, count, threadId});
+}
+
+qint64 ParseTimings::durationNs(const QString &name) const
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 duration = 0;
+    for (const Entry &e : std::as_const(m_entries)) {
+        if (e.name == name)
+            duration += e.duration;
+    }
+    return duration;
+}
+
+QString ParseTimings::report() const
+{
+    QList<Entry> entries;
+    {
+        QMutexLocker locker(&m_mutex);
+        entries = m_entries;
+    }
+    Utils::sort(entries, &Entry::start);
+
+    qsizetype nameWidth = 0;
+    for (const Entry &e : std::as_const(entries))
+        nameWidth = qMax(nameWidth, e.name.size());
+
+    QStringList lines;
+    lines << Tr::tr("Project parsing timings (total: %1 ms):").arg(elapsedNs() / 1000000);
+    for (const Entry &e : std::as_const(entries)) {
+        QString line = QString("  %1 %2 ms")
+                           .arg(e.name, -int(nameWidth))
+                           .arg(e.duration / 1000000, 6);
+        if (e.count >= 0)
+            line += ' ' + Tr::tr("(%n items)", nullptr, int(e.count));
+        lines << line;
+    }
+    return lines.join('\n');
+}
+
+QByteArray ParseTimings::chromeTrace() const
+{
+    QList<Entry> entries;
+    {
+        QMutexLocker locker(&m_mutex);
+        entries = m_entries;
+    }
+
+    // See the "Trace Event Format" documentation of the Chrome tracing tools:
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+    for (const Entry &e : std::as_const(entries)) {
+        QJsonObject event{{"name", e.name},
+                          {"cat", "cmake"},
+                          {"ph", "X"},
+                          {"ts", double(e.start) / 1000},
+                          {"dur", double(e.duration) / 1000},
+                          {"pid", pid},
+                          {"tid", qint64(e.threadId)}};
+        if (e.count >= 0)
+            event.insert("args", QJsonObject{{"count", qint64(e.count)}});
+        events.append(event);
+    }
+    return QJsonDocument(QJsonObject{{"traceEvents", events}}).toJson(QJsonDocument::Compact);
+}
+
+} // CMakeProjectManager::Internal
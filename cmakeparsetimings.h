@@ -0,0 +1,62 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+namespace CMakeProjectManager::Internal {
+
+// Wall time and item counts of the phases of one project parse, from scanning for the
+// file-api reply up to handing the project parts to the C++ code model.
+// Phases can be recorded from any thread.
+class ParseTimings
+{
+public:
+    // Records the time between its construction and destruction. A nullptr timings
+    // object turns it into a no-op.
+    class Phase
+    {
+    public:
+        Phase(ParseTimings *timings, const QString &name);
+        ~Phase();
+
+        void setCount(qsizetype count) { m_count = count; }
+
+    private:
+        ParseTimings *m_timings;
+        QString m_name;
+        qint64 m_start = 0;
+        qsizetype m_count = -1;
+    };
+
+    ParseTimings();
+
+    qint64 elapsedNs() const;
+    void record(const QString &name, qint64 startNs, qint64 durationNs, qsizetype count = -1);
+    // Total duration of all phases with this name
+    qint64 durationNs(const QString &name) const;
+
+    QString report() const;
+    QByteArray chromeTrace() const;
+
+private:
+    class Entry
+    {
+    public:
+        QString name;
+        qint64 start = 0;
+        qint64 duration = 0;
+        qsizetype count = -1;
+        quint64 threadId = 0;
+    };
+
+    QElapsedTimer m_timer;
+    mutable QMutex m_mutex;
+    QList<Entry> m_entries;
+};
+
+} // CMakeProjectManager::Internal
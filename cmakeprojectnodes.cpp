@@ -220,4 +220,17 @@ void CMakeTargetNode::setTargetInformation(const QList<FilePath> &artifacts, con
         setProductType(ProductType::Lib);
 }
 
+bool CMakeTargetNode::copyTargetInformation(const CMakeTargetNode &other)
+{
+    if (m_tooltip == other.m_tooltip && m_buildDirectory == other.m_buildDirectory
+        && m_artifact == other.m_artifact && productType() == other.productType()) {
+        return false;
+    }
+    m_tooltip = other.m_tooltip;
+    m_buildDirectory = other.m_buildDirectory;
+    m_artifact = other.m_artifact;
+    setProductType(other.productType());
+    return true;
+}
+
 } // CMakeProjectManager::Internal
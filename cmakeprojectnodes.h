@@ -49,6 +49,8 @@ public:
     CMakeTargetNode(const Utils::FilePath &directory, const QString &target);
 
     void setTargetInformation(const QList<Utils::FilePath> &artifacts, const QString &type);
+    // Returns whether the information changed
+    bool copyTargetInformation(const CMakeTargetNode &other);
 
     QString tooltip() const final;
     QString buildKey() const final;
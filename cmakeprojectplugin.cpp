@@ -10,6 +10,7 @@
 #include "cmakeformatter.h"
 #include "cmakeinstallstep.h"
 #include "cmakelocatorfilter.h"
+#include "cmakepackageindex.h"
 #include "cmakeproject.h"
 #include "cmakeprojectconstants.h"
 #include "cmakeprojectmanager.h"
@@ -62,6 +63,10 @@ public:
     CMakeInstallStepFactory installStepFactory;
     CMakeBuildTargetFilter cMakeBuildTargetFilter;
     CMakeOpenTargetFilter cMakeOpenTargetFilter;
+    CMakeSymbolFilter cMakeSymbolFilter;
+    CMakeHelpFilter cMakeHelpFilter;
+
+    CMakePackageIndex cmakePackageIndex;
 
     CMakeFormatter cmakeFormatter;
 };
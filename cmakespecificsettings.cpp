@@ -12,6 +12,7 @@
 #include <projectexplorer/projectexplorerconstants.h>
 
 #include <utils/layoutbuilder.h>
+#include <utils/pathchooser.h>
 
 using namespace Utils;
 
@@ -34,6 +35,9 @@ CMakeSpecificSettings::CMakeSpecificSettings()
             askBeforePresetsReload,
             showSourceSubFolders,
             showAdvancedOptionsByDefault,
+            loadTargetsInBackground,
+            showParseTimings,
+            parseTimingsTraceFile,
             st
         };
     });
@@ -87,6 +91,30 @@ CMakeSpecificSettings::CMakeSpecificSettings()
     showAdvancedOptionsByDefault.setLabelText(
                 ::CMakeProjectManager::Tr::tr("Show advanced options by default"));
 
+    loadTargetsInBackground.setSettingsKey("LoadTargetsInBackground");
+    loadTargetsInBackground.setDefaultValue(true);
+    loadTargetsInBackground.setLabelText(
+                ::CMakeProjectManager::Tr::tr("Show the project tree before all targets are loaded"));
+    loadTargetsInBackground.setToolTip(::CMakeProjectManager::Tr::tr(
+        "For projects with many targets, shows the targets without their files first "
+        "and adds the files once the target details are loaded."));
+
+    showParseTimings.setSettingsKey("ShowParseTimings");
+    showParseTimings.setDefaultValue(false);
+    showParseTimings.setLabelText(
+                ::CMakeProjectManager::Tr::tr("Show timings of project parsing"));
+    showParseTimings.setToolTip(::CMakeProjectManager::Tr::tr(
+        "Reports the time spent in each phase of reading the CMake project in the "
+        "build system output."));
+
+    parseTimingsTraceFile.setSettingsKey("ParseTimingsTraceFile");
+    parseTimingsTraceFile.setExpectedKind(PathChooser::SaveFile);
+    parseTimingsTraceFile.setLabelText(
+                ::CMakeProjectManager::Tr::tr("Parse timings trace file:"));
+    parseTimingsTraceFile.setToolTip(::CMakeProjectManager::Tr::tr(
+        "Writes the timings of the last project parse in the Chrome trace event format "
+        "to this file. Leave empty to disable."));
+
     readSettings();
 }
 
@@ -19,6 +19,9 @@ public:
     Utils::BoolAspect askBeforePresetsReload{this};
     Utils::BoolAspect showSourceSubFolders{this};
     Utils::BoolAspect showAdvancedOptionsByDefault{this};
+    Utils::BoolAspect loadTargetsInBackground{this};
+    Utils::BoolAspect showParseTimings{this};
+    Utils::FilePathAspect parseTimingsTraceFile{this};
 };
 
 CMakeSpecificSettings &settings();
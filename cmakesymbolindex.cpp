@@ -0,0 +1,236 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cmakesymbolindex.h"
+
+#include "cmakeprojectmanagertr.h"
+
+#include <utils/algorithm.h>
+
+#include <QDataStream>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QSaveFile>
+
+using namespace Utils;
+
+namespace CMakeProjectManager::Internal {
+
+static Q_LOGGING_CATEGORY(cmakeSymbolIndexLog, "qtc.cmake.symbolIndex", QtWarningMsg);
+
+const char INDEX_RELATIVE_PATH[] = ".qtc/cmake-symbols.index";
+const quint32 INDEX_MAGIC = 0x51435349; // "QCSI"
+const quint32 INDEX_VERSION = 1;
+const quint32 INDEX_END_MARKER = 0x454e4421; // "END!"
+
+static quint64 trigram(const QString &lowerName, qsizetype i)
+{
+    return quint64(lowerName.at(i).unicode()) << 32 | quint64(lowerName.at(i + 1).unicode()) << 16
+           | quint64(lowerName.at(i + 2).unicode());
+}
+
+CMakeSymbolIndex::CMakeSymbolIndex(QList<Entry> entries)
+    : m_entries(std::move(entries))
+{
+    std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry &a, const Entry &b) {
+        return a.name.compare(b.name, Qt::CaseInsensitive) < 0;
+    });
+    buildTrigrams();
+}
+
+void CMakeSymbolIndex::buildTrigrams()
+{
+    m_lowerNames.clear();
+    m_lowerNames.reserve(m_entries.size());
+    m_trigrams.clear();
+    for (int index = 0; index < m_entries.size(); ++index) {
+        const QString lowerName = m_entries.at(index).name.toLower();
+        for (qsizetype i = 0; i + 3 <= lowerName.size(); ++i) {
+            QList<int> &postings = m_trigrams[trigram(lowerName, i)];
+            // Entries are visited in order, so this keeps the list sorted and unique
+            if (postings.isEmpty() || postings.last() != index)
+                postings.append(index);
+        }
+        m_lowerNames.append(lowerName);
+    }
+}
+
+QList<const CMakeSymbolIndex::Entry *> CMakeSymbolIndex::search(const QString &text,
+                                                                int limit) const
+{
+    const QString lowerText = text.toLower();
+
+    // Candidates contain the rarest trigram of the text, all of them if the text is short
+    const QList<int> *candidates = nullptr;
+    if (lowerText.size() >= 3) {
+        for (qsizetype i = 0; i + 3 <= lowerText.size(); ++i) {
+            const auto it = m_trigrams.constFind(trigram(lowerText, i));
+            if (it == m_trigrams.constEnd())
+                return {};
+            if (!candidates || it->size() < candidates->size())
+                candidates = &*it;
+        }
+    }
+
+    QList<const Entry *> prefixMatches;
+    QList<const Entry *> otherMatches;
+    const auto check = [&](int index) {
+        const qsizetype position = m_lowerNames.at(index).indexOf(lowerText);
+        if (position == 0)
+            prefixMatches.append(&m_entries.at(index));
+        else if (position > 0)
+            otherMatches.append(&m_entries.at(index));
+    };
+    if (candidates) {
+        for (int index : *candidates)
+            check(index);
+    } else {
+        for (int index = 0; index < m_entries.size(); ++index)
+            check(index);
+    }
+
+    QList<const Entry *> result = prefixMatches + otherMatches;
+    if (limit >= 0 && result.size() > limit)
+        result.resize(limit);
+    return result;
+}
+
+QHash<QString, Link> CMakeSymbolIndex::navigationLinks() const
+{
+    QHash<QString, Link> result;
+    for (const Entry &entry : m_entries) {
+        if (entry.kind != Variable)
+            result.insert(entry.name, entry.link);
+    }
+    return result;
+}
+
+QString CMakeSymbolIndex::kindDisplayName(Kind kind)
+{
+    switch (kind) {
+    case Function:
+        return Tr::tr("Function");
+    case Macro:
+        return Tr::tr("Macro");
+    case Option:
+        return Tr::tr("Option");
+    case Variable:
+        return Tr::tr("Variable");
+    case ImportedTarget:
+        return Tr::tr("Imported target");
+    case Target:
+        return Tr::tr("Target");
+    case FindPackageVariable:
+        return Tr::tr("Package variable");
+    }
+    return {};
+}
+
+// --------------------------------------------------------------------
+// Storage:
+// --------------------------------------------------------------------
+
+FilePath CMakeSymbolIndex::indexFile(const FilePath &buildDirectory)
+{
+    return buildDirectory.pathAppended(INDEX_RELATIVE_PATH);
+}
+
+bool CMakeSymbolIndex::write(const FilePath &buildDirectory,
+                             const FilePath &sourceDirectory) const
+{
+    // Written with QSaveFile, so it needs to be a local file
+    if (buildDirectory.isEmpty() || buildDirectory.needsDevice())
+        return false;
+    const FilePath file = indexFile(buildDirectory);
+    if (!file.parentDir().ensureWritableDir())
+        return false;
+
+    QByteArray contents;
+    {
+        QDataStream s(&contents, QIODevice::WriteOnly);
+        s.setVersion(QDataStream::Qt_6_0);
+        s << INDEX_MAGIC << INDEX_VERSION << sourceDirectory.toString();
+
+        // A project has few CMake files, store each path once and refer to it by index
+        QHash<FilePath, qint32> fileIndexes;
+        QStringList files;
+        for (const Entry &entry : m_entries) {
+            if (!fileIndexes.contains(entry.link.targetFilePath)) {
+                fileIndexes.insert(entry.link.targetFilePath, files.size());
+                files.append(entry.link.targetFilePath.toString());
+            }
+        }
+        s << files << qint32(m_entries.size());
+        for (const Entry &entry : m_entries) {
+            s << entry.name << quint8(entry.kind) << fileIndexes.value(entry.link.targetFilePath)
+              << qint32(entry.link.targetLine) << qint32(entry.link.targetColumn);
+        }
+        s << INDEX_END_MARKER;
+    }
+
+    QSaveFile saveFile(file.toFSPathString());
+    if (!saveFile.open(QIODevice::WriteOnly) || saveFile.write(contents) != contents.size()
+        || !saveFile.commit()) {
+        qCWarning(cmakeSymbolIndexLog) << "Failed to write symbol index" << file;
+        return false;
+    }
+    qCDebug(cmakeSymbolIndexLog) << "Wrote" << m_entries.size() << "symbols to" << file;
+    return true;
+}
+
+std::optional<CMakeSymbolIndex> CMakeSymbolIndex::read(const FilePath &buildDirectory,
+                                                       const FilePath &sourceDirectory)
+{
+    if (buildDirectory.isEmpty() || buildDirectory.needsDevice())
+        return {};
+    QFile file(indexFile(buildDirectory).toFSPathString());
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    QDataStream s(&file);
+    s.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString storedSourceDirectory;
+    s >> magic >> version >> storedSourceDirectory;
+    if (s.status() != QDataStream::Ok || magic != INDEX_MAGIC || version != INDEX_VERSION
+        || FilePath::fromString(storedSourceDirectory) != sourceDirectory) {
+        qCDebug(cmakeSymbolIndexLog) << "Outdated symbol index" << file.fileName();
+        return {};
+    }
+
+    QStringList fileNames;
+    qint32 count = 0;
+    s >> fileNames >> count;
+    const QList<FilePath> files = Utils::transform(fileNames, &FilePath::fromString);
+
+    CMakeSymbolIndex index;
+    for (qint32 i = 0; i < count && s.status() == QDataStream::Ok; ++i) {
+        Entry entry;
+        quint8 kind = 0;
+        qint32 fileIndex = 0;
+        qint32 line = 0;
+        qint32 column = 0;
+        s >> entry.name >> kind >> fileIndex >> line >> column;
+        if (fileIndex < 0 || fileIndex >= files.size() || kind > FindPackageVariable) {
+            s.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+        entry.kind = Kind(kind);
+        entry.link = Link(files.at(fileIndex), line, column);
+        index.m_entries.append(entry);
+    }
+
+    quint32 endMarker = 0;
+    s >> endMarker;
+    if (s.status() != QDataStream::Ok || endMarker != INDEX_END_MARKER) {
+        qCWarning(cmakeSymbolIndexLog) << "Broken symbol index" << file.fileName();
+        return {};
+    }
+
+    index.buildTrigrams();
+    qCDebug(cmakeSymbolIndexLog) << "Read" << count << "symbols from" << file.fileName();
+    return index;
+}
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,83 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+#include <utils/link.h>
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+namespace CMakeProjectManager::Internal {
+
+// The definitions in the CMake files of a project, searchable by name.
+//
+// The index of the last parse is stored in the build directory, so that navigation and
+// the locator work right after opening a project, before CMake and the parse are done.
+class CMakeSymbolIndex
+{
+public:
+    enum Kind : quint8 {
+        Function,
+        Macro,
+        Option,
+        Variable,
+        ImportedTarget,
+        Target,
+        FindPackageVariable
+    };
+
+    class Entry
+    {
+    public:
+        bool operator==(const Entry &other) const
+        {
+            return name == other.name && kind == other.kind && link == other.link;
+        }
+
+        QString name;
+        Kind kind = Function;
+        Utils::Link link;
+    };
+
+    CMakeSymbolIndex() = default;
+    explicit CMakeSymbolIndex(QList<Entry> entries);
+
+    bool isEmpty() const { return m_entries.isEmpty(); }
+    const QList<Entry> &entries() const { return m_entries; }
+    bool hasSameEntries(const CMakeSymbolIndex &other) const
+    {
+        return m_entries == other.m_entries;
+    }
+
+    // Entries whose name contains text, ignoring case. Names starting with text come first.
+    // Lookups of three or more characters go through a trigram index.
+    QList<const Entry *> search(const QString &text, int limit = -1) const;
+
+    // Links for jumping to a definition by its exact name. set() variables are left out,
+    // a variable is usually set in many places.
+    QHash<QString, Utils::Link> navigationLinks() const;
+
+    static QString kindDisplayName(Kind kind);
+
+    static Utils::FilePath indexFile(const Utils::FilePath &buildDirectory);
+    bool write(const Utils::FilePath &buildDirectory,
+               const Utils::FilePath &sourceDirectory) const;
+    // Returns nothing if there is no index or it belongs to another source directory
+    static std::optional<CMakeSymbolIndex> read(const Utils::FilePath &buildDirectory,
+                                                const Utils::FilePath &sourceDirectory);
+
+private:
+    void buildTrigrams();
+
+    QList<Entry> m_entries;   // Sorted by name, ignoring case
+    QStringList m_lowerNames; // Of m_entries
+    QHash<quint64, QList<int>> m_trigrams; // Trigram of the lower case names to entry indexes
+};
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,192 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cmakesymbols.h"
+
+#include <utils/algorithm.h>
+#include <utils/qtcassert.h>
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+
+using namespace Utils;
+
+namespace CMakeProjectManager::Internal {
+
+static Link argumentLink(const FilePath &filePath, const cmListFileArgument &arg)
+{
+    Link link;
+    link.targetFilePath = filePath;
+    link.targetLine = arg.Line;
+    link.targetColumn = arg.Column - 1;
+    return link;
+}
+
+static std::shared_ptr<const CMakeFileSymbols> scanCMakeFile(const CMakeFileInfo &cmakeFile)
+{
+    auto result = std::make_shared<CMakeFileSymbols>();
+    result->lastModified = cmakeFile.lastModified;
+    result->size = cmakeFile.size;
+
+    for (const cmListFileFunction &func : cmakeFile.cmakeListFile.Functions) {
+        const std::vector<cmListFileArgument> &arguments = func.Arguments();
+        if (arguments.empty())
+            continue;
+        const cmListFileArgument &firstArgument = arguments.front();
+        const std::string &name = func.LowerCaseName();
+
+        if (name == "function" || name == "macro" || name == "option") {
+            CMakeSymbol symbol{QString::fromUtf8(firstArgument.Value),
+                               argumentLink(cmakeFile.path, firstArgument)};
+            if (name == "option")
+                result->options.append(symbol);
+            else if (name == "macro")
+                result->macros.append(symbol);
+            else
+                result->functions.append(symbol);
+        } else if (name == "set") {
+            const QString variableName = QString::fromUtf8(firstArgument.Value);
+            if (!variableName.contains("${"))
+                result->variables.append(
+                    {variableName, argumentLink(cmakeFile.path, firstArgument)});
+        } else if (name == "add_library") {
+            const QString targetName = QString::fromUtf8(firstArgument.Value);
+            const bool haveImported = Utils::contains(arguments, [](const auto &arg) {
+                return arg.Value == "IMPORTED";
+            });
+            if (haveImported && !targetName.contains("${"))
+                result->importedTargets.append(
+                    {targetName, argumentLink(cmakeFile.path, firstArgument)});
+        } else if (name == "find_package_handle_standard_args") {
+            for (const cmListFileArgument &arg : arguments) {
+                if (arg == firstArgument)
+                    continue;
+                const QString value = QString::fromUtf8(arg.Value);
+                if (value.contains("${") || (value.startsWith('"') && value.endsWith('"'))
+                    || (value.startsWith("'") && value.endsWith("'")))
+                    continue;
+                result->findPackageArguments.append({value, argumentLink(cmakeFile.path, arg)});
+            }
+        }
+    }
+    return result;
+}
+
+// The file-api only reports the line of a target definition, the link needs the column of
+// the target name.
+static std::optional<Link> projectTargetLink(const CMakeFileInfo &cmakeFile, int line)
+{
+    const std::vector<cmListFileFunction> &functions = cmakeFile.cmakeListFile.Functions;
+    auto it = std::lower_bound(functions.begin(), functions.end(), line,
+                               [](const cmListFileFunction &func, int line) {
+                                   return func.Line() < line;
+                               });
+    std::optional<Link> result;
+    for (; it != functions.end() && it->Line() == line; ++it) {
+        if (!it->Arguments().empty())
+            result = argumentLink(cmakeFile.path, it->Arguments().front());
+    }
+    return result;
+}
+
+void collectCMakeSymbols(QPromise<CMakeSymbols> &promise, const CMakeSymbolsInput &input)
+{
+    const QList<CMakeFileInfo> cmakeFiles = Utils::toList(input.cmakeFiles);
+
+    // Files restored from a snapshot have no time stamp and are always scanned.
+    const auto isUnchanged = [&input](const CMakeFileInfo &cmakeFile) {
+        const std::shared_ptr<const CMakeFileSymbols> cached = input.cache.value(cmakeFile.path);
+        return cached && cmakeFile.lastModified.isValid()
+               && cached->lastModified == cmakeFile.lastModified
+               && cached->size == cmakeFile.size;
+    };
+
+    std::atomic_int scannedFiles = 0;
+    const QList<std::shared_ptr<const CMakeFileSymbols>> fileSymbols
+        = QtConcurrent::blockingMapped<QList<std::shared_ptr<const CMakeFileSymbols>>>(
+            cmakeFiles,
+            [&](const CMakeFileInfo &cmakeFile) -> std::shared_ptr<const CMakeFileSymbols> {
+                if (promise.isCanceled())
+                    return {};
+                if (isUnchanged(cmakeFile))
+                    return input.cache.value(cmakeFile.path);
+                ++scannedFiles;
+                return scanCMakeFile(cmakeFile);
+            });
+
+    if (promise.isCanceled())
+        return;
+
+    CMakeSymbols result;
+    result.scannedFiles = scannedFiles;
+    result.cache.reserve(cmakeFiles.size());
+
+    QList<CMakeSymbolIndex::Entry> indexEntries;
+    const auto addToIndex = [&indexEntries](const QList<CMakeSymbol> &symbols,
+                                            CMakeSymbolIndex::Kind kind) {
+        for (const CMakeSymbol &symbol : symbols)
+            indexEntries.append({symbol.name, kind, symbol.link});
+    };
+
+    for (qsizetype i = 0; i < cmakeFiles.size(); ++i) {
+        const CMakeFileInfo &cmakeFile = cmakeFiles.at(i);
+        const std::shared_ptr<const CMakeFileSymbols> &symbols = fileSymbols.at(i);
+        QTC_ASSERT(symbols, continue);
+        result.cache.insert(cmakeFile.path, symbols);
+
+        for (const QList<CMakeSymbol> *functions : {&symbols->functions, &symbols->macros}) {
+            for (const CMakeSymbol &function : *functions) {
+                result.symbols.insert(function.name, function.link);
+                result.keywords.functions[function.name] = FilePath();
+            }
+        }
+        for (const CMakeSymbol &option : symbols->options) {
+            result.symbols.insert(option.name, option.link);
+            result.keywords.variables[option.name] = FilePath();
+        }
+        addToIndex(symbols->functions, CMakeSymbolIndex::Function);
+        addToIndex(symbols->macros, CMakeSymbolIndex::Macro);
+        addToIndex(symbols->options, CMakeSymbolIndex::Option);
+        addToIndex(symbols->variables, CMakeSymbolIndex::Variable);
+
+        for (const CMakeSymbol &target : symbols->importedTargets) {
+            result.importedTargets << target.name;
+            // Allow navigation to the imported target
+            result.symbols.insert(target.name, target.link);
+        }
+        addToIndex(symbols->importedTargets, CMakeSymbolIndex::ImportedTarget);
+
+        const QList<QPair<int, QString>> projectTargets = input.projectTargets.values(
+            cmakeFile.path);
+        for (const auto &[line, title] : projectTargets) {
+            if (const std::optional<Link> link = projectTargetLink(cmakeFile, line)) {
+                result.symbols.insert(title, *link);
+                indexEntries.append({title, CMakeSymbolIndex::Target, *link});
+            }
+        }
+
+        for (const CMakeSymbol &argument : symbols->findPackageArguments) {
+            if (input.findPackageKeywords.contains(argument.name))
+                continue;
+            result.findPackageVariables << argument.name;
+            result.symbols.insert(argument.name, argument.link);
+            indexEntries.append({argument.name, CMakeSymbolIndex::FindPackageVariable,
+                                 argument.link});
+        }
+    }
+    result.findPackageVariables.removeDuplicates();
+
+    const auto index = std::make_shared<CMakeSymbolIndex>(std::move(indexEntries));
+    const bool isStored = input.previousIndex && input.previousIndex->hasSameEntries(*index)
+                          && CMakeSymbolIndex::indexFile(input.buildDirectory).exists();
+    if (!input.buildDirectory.isEmpty() && !isStored)
+        index->write(input.buildDirectory, input.sourceDirectory);
+    result.index = index;
+
+    promise.addResult(result);
+}
+
+} // CMakeProjectManager::Internal
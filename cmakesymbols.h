@@ -0,0 +1,89 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include "cmakesymbolindex.h"
+#include "cmaketool.h"
+#include "fileapidataextractor.h"
+
+#include <utils/filepath.h>
+#include <utils/link.h>
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QPromise>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+namespace CMakeProjectManager::Internal {
+
+class CMakeSymbol
+{
+public:
+    QString name;
+    Utils::Link link;
+};
+
+// What a single CMake file contributes to the symbols of the project. It only depends on
+// the contents of the file, so it is kept for the files that did not change since the
+// last parse.
+class CMakeFileSymbols
+{
+public:
+    QDateTime lastModified;
+    qint64 size = -1;
+
+    QList<CMakeSymbol> functions;       // function()
+    QList<CMakeSymbol> macros;          // macro()
+    QList<CMakeSymbol> options;         // option()
+    QList<CMakeSymbol> variables;       // set(), only for the symbol index
+    QList<CMakeSymbol> importedTargets; // add_library(... IMPORTED)
+    // Arguments of find_package_handle_standard_args() that may name result variables.
+    // The keywords of the command are only filtered out when merging, they depend on the
+    // CMake tool.
+    QList<CMakeSymbol> findPackageArguments;
+};
+
+using CMakeFileSymbolsCache = QHash<Utils::FilePath, std::shared_ptr<const CMakeFileSymbols>>;
+
+class CMakeSymbolsInput
+{
+public:
+    QSet<CMakeFileInfo> cmakeFiles;
+    // The line of the command that defines a target and its title, per CMake file
+    QMultiHash<Utils::FilePath, QPair<int, QString>> projectTargets;
+    QSet<QString> findPackageKeywords; // Of find_package_handle_standard_args()
+    CMakeFileSymbolsCache cache;
+
+    // Where to store the symbol index, nothing is stored if empty
+    Utils::FilePath buildDirectory;
+    Utils::FilePath sourceDirectory;
+    // The stored index is only rewritten if its symbols differ from these
+    std::shared_ptr<const CMakeSymbolIndex> previousIndex;
+};
+
+class CMakeSymbols
+{
+public:
+    QHash<QString, Utils::Link> symbols;
+    CMakeKeywords keywords; // Only functions and variables
+    QStringList importedTargets;
+    QStringList findPackageVariables;
+
+    std::shared_ptr<const CMakeSymbolIndex> index;
+
+    CMakeFileSymbolsCache cache;
+    int scannedFiles = 0;
+};
+
+// Scans the changed files concurrently and merges their symbols with the cached ones of
+// the unchanged files. The resulting index is also written to the build directory, unless
+// it has the symbols of the previous one.
+void collectCMakeSymbols(QPromise<CMakeSymbols> &promise, const CMakeSymbolsInput &input);
+
+} // CMakeProjectManager::Internal
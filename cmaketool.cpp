@@ -3,19 +3,26 @@
 
 #include "cmaketool.h"
 
+#include "cmakehelpindex.h"
 #include "cmakeprojectmanagertr.h"
 #include "cmaketoolmanager.h"
 
 #include <coreplugin/icore.h>
 #include <coreplugin/helpmanager.h>
 
+#include <extensionsystem/pluginmanager.h>
+
+#include <projectexplorer/projectexplorer.h>
+
 #include <utils/algorithm.h>
+#include <utils/async.h>
 #include <utils/environment.h>
 #include <utils/persistentcachestore.h>
 #include <utils/process.h>
 #include <utils/qtcassert.h>
 #include <utils/temporarydirectory.h>
 
+#include <QDateTime>
 #include <QDir>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -83,16 +90,24 @@ public:
     std::pair<int, int> version;
 };
 
+// The keywords are loaded in the background, shared with the loading task so that the tool
+// can go away meanwhile
+class KeywordsData
+{
+public:
+    QMutex m_mutex;
+    CMakeKeywords m_keywords;
+};
+
 class IntrospectionData
 {
 public:
     bool m_didAttemptToRun = false;
     bool m_haveCapabilitites = true;
-    bool m_haveKeywords = false;
+    bool m_didRequestKeywords = false;
 
     QList<CMakeTool::Generator> m_generators;
-    CMakeKeywords m_keywords;
-    QMutex m_keywordsMutex;
+    std::shared_ptr<KeywordsData> m_keywordsData = std::make_shared<KeywordsData>();
     QVector<FileApi> m_fileApis;
     CMakeTool::Version m_version;
 };
@@ -147,7 +162,8 @@ void CMakeTool::setFilePath(const FilePath &executable)
 
     m_introspection = std::make_unique<Internal::IntrospectionData>();
 
-    m_executable = executable;
+    const FilePath previousExecutable = std::exchange(m_executable, executable);
+    CMakeToolManager::releaseHelpIndex(previousExecutable);
     CMakeToolManager::notifyAboutUpdate(this);
 }
 
@@ -167,9 +183,11 @@ bool CMakeTool::isValid(bool ignoreCache) const
     return m_introspection->m_haveCapabilitites && !m_introspection->m_fileApis.isEmpty();
 }
 
-void CMakeTool::runCMake(Process &cmake, const QStringList &args, int timeoutS) const
+static void runCMakeExecutable(Process &cmake,
+                               const FilePath &executable,
+                               const QStringList &args,
+                               int timeoutS)
 {
-    const FilePath executable = cmakeExecutable();
     cmake.setTimeoutS(timeoutS);
     cmake.setDisableUnixTerminal();
     Environment env = executable.deviceEnvironment();
@@ -180,6 +198,11 @@ void CMakeTool::runCMake(Process &cmake, const QStringList &args, int timeoutS)
     cmake.runBlocking();
 }
 
+void CMakeTool::runCMake(Process &cmake, const QStringList &args, int timeoutS) const
+{
+    runCMakeExecutable(cmake, cmakeExecutable(), args, timeoutS);
+}
+
 Store CMakeTool::toMap() const
 {
     Store data;
@@ -247,84 +270,298 @@ QList<CMakeTool::Generator> CMakeTool::supportedGenerators() const
     return isValid() ? m_introspection->m_generators : QList<CMakeTool::Generator>();
 }
 
-CMakeKeywords CMakeTool::keywords()
+static QStringList parseSyntaxHighlightingXml(CMakeKeywords &keywords)
 {
-    if (!isValid())
-        return {};
+    QStringList moduleFunctions;
 
-    if (!m_introspection->m_haveKeywords && m_introspection->m_haveCapabilitites) {
-        QMutexLocker locker(&m_introspection->m_keywordsMutex);
-        if (m_introspection->m_haveKeywords)
-            return m_introspection->m_keywords;
+    const FilePath cmakeXml = Core::ICore::resourcePath("generic-highlighter/syntax/cmake.xml");
+    QXmlStreamReader reader(cmakeXml.fileContents().value_or(QByteArray()));
 
-        Process proc;
+    auto readItemList = [](QXmlStreamReader &reader) -> QStringList {
+        QStringList arguments;
+        while (!reader.atEnd() && reader.readNextStartElement()) {
+            if (reader.name() == u"item")
+                arguments.append(reader.readElementText());
+            else
+                reader.skipCurrentElement();
+        }
+        return arguments;
+    };
 
-        const FilePath findCMakeRoot = TemporaryDirectory::masterDirectoryFilePath()
-                                       / "find-root.cmake";
-        findCMakeRoot.writeFileContents("message(${CMAKE_ROOT})");
+    while (!reader.atEnd() && reader.readNextStartElement()) {
+        if (reader.name() != u"highlighting")
+            continue;
+        while (!reader.atEnd() && reader.readNextStartElement()) {
+            if (reader.name() == u"list") {
+                const auto name = reader.attributes().value("name").toString();
+                if (name.endsWith(u"_sargs") || name.endsWith(u"_nargs")) {
+                    const auto functionName = name.left(name.length() - 6);
+                    QStringList arguments = readItemList(reader);
 
-        FilePath cmakeRoot;
-        runCMake(proc, {"-P", findCMakeRoot.nativePath()}, 5);
-        if (proc.result() == ProcessResult::FinishedWithSuccess) {
-            QStringList output = filtered(proc.allOutput().split('\n'),
-                                          std::not_fn(&QString::isEmpty));
-            if (output.size() > 0)
-                cmakeRoot = FilePath::fromString(output[0]);
-        }
+                    if (keywords.functionArgs.contains(functionName))
+                        arguments.append(keywords.functionArgs.value(functionName));
 
-        const struct
-        {
-            const QString helpPath;
-            QMap<QString, FilePath> &targetMap;
-        } introspections[] = {
-            // Functions
-            {"Help/command", m_introspection->m_keywords.functions},
-            // Properties
-            {"Help/prop_dir", m_introspection->m_keywords.directoryProperties},
-            {"Help/prop_sf", m_introspection->m_keywords.sourceProperties},
-            {"Help/prop_test", m_introspection->m_keywords.testProperties},
-            {"Help/prop_tgt", m_introspection->m_keywords.targetProperties},
-            {"Help/prop_gbl", m_introspection->m_keywords.properties},
-            // Variables
-            {"Help/variable", m_introspection->m_keywords.variables},
-            // Policies
-            {"Help/policy", m_introspection->m_keywords.policies},
-            // Environment Variables
-            {"Help/envvar", m_introspection->m_keywords.environmentVariables},
-        };
-        for (auto &i : introspections) {
-            const FilePaths files = cmakeRoot.pathAppended(i.helpPath)
-                                        .dirEntries({{"*.rst"}, QDir::Files}, QDir::Name);
-            for (const auto &filePath : files)
-                i.targetMap[filePath.completeBaseName()] = filePath;
-        }
+                    keywords.functionArgs[functionName] = arguments;
 
-        for (const auto &map : {m_introspection->m_keywords.directoryProperties,
-                                m_introspection->m_keywords.sourceProperties,
-                                m_introspection->m_keywords.testProperties,
-                                m_introspection->m_keywords.targetProperties}) {
-            m_introspection->m_keywords.properties.insert(map);
+                    // Functions that are part of CMake modules like ExternalProject_Add
+                    // which are not reported by cmake --help-list-commands
+                    if (!keywords.functions.contains(functionName)) {
+                        moduleFunctions << functionName;
+                    }
+                } else if (name == u"generator-expressions") {
+                    keywords.generatorExpressions = toSet(readItemList(reader));
+                } else {
+                    reader.skipCurrentElement();
+                }
+            } else {
+                reader.skipCurrentElement();
+            }
         }
+    }
 
-        // Modules
-        const FilePaths files
-            = cmakeRoot.pathAppended("Help/module").dirEntries({{"*.rst"}, QDir::Files}, QDir::Name);
-        for (const FilePath &filePath : files) {
-            const QString fileName = filePath.completeBaseName();
-            if (fileName.startsWith("Find"))
-                m_introspection->m_keywords.findModules[fileName.mid(4)] = filePath;
-            else
-                m_introspection->m_keywords.includeStandardModules[fileName] = filePath;
-        }
+    // Some commands have the same arguments as other commands and the `cmake.xml`
+    // but their relationship is weirdly defined in the `cmake.xml` file.
+    using ListStringPair = QList<QPair<QString, QString>>;
+    const ListStringPair functionPairs = {{"if", "elseif"},
+                                          {"while", "elseif"},
+                                          {"find_path", "find_file"},
+                                          {"find_program", "find_library"},
+                                          {"target_link_libraries", "target_compile_definitions"},
+                                          {"target_link_options", "target_compile_definitions"},
+                                          {"target_link_directories", "target_compile_options"},
+                                          {"set_target_properties", "set_directory_properties"},
+                                          {"set_tests_properties", "set_directory_properties"}};
+    for (const auto &pair : std::as_const(functionPairs)) {
+        if (!keywords.functionArgs.contains(pair.first))
+            keywords.functionArgs[pair.first] = keywords.functionArgs.value(pair.second);
+    }
+
+    // Special case for cmake_print_variables, which will print the names and values for variables
+    // and needs to be as a known function
+    const QString cmakePrintVariables("cmake_print_variables");
+    keywords.functionArgs[cmakePrintVariables] = {};
+    moduleFunctions << cmakePrintVariables;
+
+    moduleFunctions.removeDuplicates();
+    return moduleFunctions;
+}
+
+// The script is the same for all tools, so it is written once for the parallel loads
+static FilePath findCMakeRootScript()
+{
+    static const FilePath script = [] {
+        const FilePath path = TemporaryDirectory::masterDirectoryFilePath() / "find-root.cmake";
+        path.writeFileContents("message(${CMAKE_ROOT})");
+        return path;
+    }();
+    return script;
+}
+
+// Collects the keywords from the help files of CMake and the syntax highlighting definition
+static CMakeKeywords introspectKeywords(const FilePath &executable)
+{
+    CMakeKeywords keywords;
+
+    Process proc;
+
+    FilePath cmakeRoot;
+    runCMakeExecutable(proc, executable, {"-P", findCMakeRootScript().nativePath()}, 5);
+    if (proc.result() == ProcessResult::FinishedWithSuccess) {
+        QStringList output = filtered(proc.allOutput().split('\n'),
+                                      std::not_fn(&QString::isEmpty));
+        if (output.size() > 0)
+            cmakeRoot = FilePath::fromString(output[0]);
+    }
+
+    const struct
+    {
+        const QString helpPath;
+        QMap<QString, FilePath> &targetMap;
+    } introspections[] = {
+        // Functions
+        {"Help/command", keywords.functions},
+        // Properties
+        {"Help/prop_dir", keywords.directoryProperties},
+        {"Help/prop_sf", keywords.sourceProperties},
+        {"Help/prop_test", keywords.testProperties},
+        {"Help/prop_tgt", keywords.targetProperties},
+        {"Help/prop_gbl", keywords.properties},
+        // Variables
+        {"Help/variable", keywords.variables},
+        // Policies
+        {"Help/policy", keywords.policies},
+        // Environment Variables
+        {"Help/envvar", keywords.environmentVariables},
+    };
+    for (auto &i : introspections) {
+        const FilePaths files = cmakeRoot.pathAppended(i.helpPath)
+                                    .dirEntries({{"*.rst"}, QDir::Files}, QDir::Name);
+        for (const auto &filePath : files)
+            i.targetMap[filePath.completeBaseName()] = filePath;
+    }
 
-        const QStringList moduleFunctions = parseSyntaxHighlightingXml();
-        for (const auto &function : moduleFunctions)
-            m_introspection->m_keywords.functions[function] = FilePath();
+    for (const auto &map : {keywords.directoryProperties,
+                            keywords.sourceProperties,
+                            keywords.testProperties,
+                            keywords.targetProperties}) {
+        keywords.properties.insert(map);
+    }
+
+    // Modules
+    const FilePaths files
+        = cmakeRoot.pathAppended("Help/module").dirEntries({{"*.rst"}, QDir::Files}, QDir::Name);
+    for (const FilePath &filePath : files) {
+        const QString fileName = filePath.completeBaseName();
+        if (fileName.startsWith("Find"))
+            keywords.findModules[fileName.mid(4)] = filePath;
+        else
+            keywords.includeStandardModules[fileName] = filePath;
+    }
+
+    const QStringList moduleFunctions = parseSyntaxHighlightingXml(keywords);
+    for (const auto &function : moduleFunctions)
+        keywords.functions[function] = FilePath();
+
+    return keywords;
+}
+
+// Bump when the content of the keywords changes
+const int keywordsCacheVersion = 1;
+
+static const struct
+{
+    const char *key;
+    QMap<QString, FilePath> CMakeKeywords::*map;
+} keywordMaps[] = {{"Variables", &CMakeKeywords::variables},
+                   {"Functions", &CMakeKeywords::functions},
+                   {"Properties", &CMakeKeywords::properties},
+                   {"EnvironmentVariables", &CMakeKeywords::environmentVariables},
+                   {"DirectoryProperties", &CMakeKeywords::directoryProperties},
+                   {"SourceProperties", &CMakeKeywords::sourceProperties},
+                   {"TargetProperties", &CMakeKeywords::targetProperties},
+                   {"TestProperties", &CMakeKeywords::testProperties},
+                   {"IncludeStandardModules", &CMakeKeywords::includeStandardModules},
+                   {"FindModules", &CMakeKeywords::findModules},
+                   {"Policies", &CMakeKeywords::policies}};
+
+static Store keywordsToStore(const CMakeKeywords &keywords)
+{
+    Store store;
+    for (const auto &m : keywordMaps) {
+        QVariantMap map;
+        const QMap<QString, FilePath> &keywordMap = keywords.*m.map;
+        for (auto it = keywordMap.cbegin(); it != keywordMap.cend(); ++it)
+            map.insert(it.key(), it.value().toSettings());
+        store.insert(m.key, map);
+    }
+    store.insert("GeneratorExpressions", QStringList(keywords.generatorExpressions.cbegin(),
+                                                     keywords.generatorExpressions.cend()));
+    QVariantMap functionArgs;
+    for (auto it = keywords.functionArgs.cbegin(); it != keywords.functionArgs.cend(); ++it)
+        functionArgs.insert(it.key(), it.value());
+    store.insert("FunctionArgs", functionArgs);
+    return store;
+}
+
+static CMakeKeywords keywordsFromStore(const Store &store)
+{
+    CMakeKeywords keywords;
+    for (const auto &m : keywordMaps) {
+        const QVariantMap map = store.value(m.key).toMap();
+        QMap<QString, FilePath> &keywordMap = keywords.*m.map;
+        for (auto it = map.cbegin(); it != map.cend(); ++it)
+            keywordMap.insert(it.key(), FilePath::fromSettings(it.value()));
+    }
+    keywords.generatorExpressions = toSet(store.value("GeneratorExpressions").toStringList());
+    const QVariantMap functionArgs = store.value("FunctionArgs").toMap();
+    for (auto it = functionArgs.cbegin(); it != functionArgs.cend(); ++it)
+        keywords.functionArgs.insert(it.key(), it.value().toStringList());
+    return keywords;
+}
+
+// Runs in the background. The keywords only change with the CMake executable, and with the
+// syntax highlighting definition that comes with Qt Creator. The index of their help files is
+// loaded right after them. Returns whether there are keywords.
+static bool loadKeywords(const std::shared_ptr<Internal::KeywordsData> &data,
+                         const FilePath &executable)
+{
+    const Key cacheKey = keyFromString("CMakeKeywords_" + executable.toUserOutput());
+    // Stored as numbers, these survive the round trip through the cache unchanged
+    const QDateTime executableModified = executable.lastModified();
+    const qint64 executableStamp = executableModified.toMSecsSinceEpoch();
+    const qint64 syntaxStamp = Core::ICore::resourcePath("generic-highlighter/syntax/cmake.xml")
+                                   .lastModified()
+                                   .toMSecsSinceEpoch();
+
+    CMakeKeywords keywords;
+    const expected_str<Store> cache = PersistentCacheStore::byKey(cacheKey);
+    if (cache && cache->value("Version").toInt() == keywordsCacheVersion
+        && executableModified.isValid()
+        && cache->value("ExecutableModified").toLongLong() == executableStamp
+        && cache->value("SyntaxModified").toLongLong() == syntaxStamp) {
+        keywords = keywordsFromStore(*cache);
+        qCDebug(cmakeToolLog) << "Keywords of" << executable << "read from the cache";
+    } else {
+        keywords = introspectKeywords(executable);
+        // Do not keep the result of a CMake that could not be run
+        if (!keywords.variables.isEmpty() && executableModified.isValid()) {
+            Store store = keywordsToStore(keywords);
+            store.insert("Version", keywordsCacheVersion);
+            store.insert("ExecutableModified", executableStamp);
+            store.insert("SyntaxModified", syntaxStamp);
+            const expected_str<void> result = PersistentCacheStore::write(cacheKey, store);
+            if (!result)
+                qCWarning(cmakeToolLog) << "Caching the keywords failed:" << result.error();
+        }
+    }
 
-        m_introspection->m_haveKeywords = true;
+    {
+        QMutexLocker locker(&data->m_mutex);
+        data->m_keywords = keywords;
     }
 
-    return m_introspection->m_keywords;
+    // The tooltips and the documentation search come from the help files of the keywords
+    Internal::CMakeHelpIndex::setIndex(executable, Internal::CMakeHelpIndex::load(keywords));
+    return !keywords.variables.isEmpty();
+}
+
+CMakeKeywords CMakeTool::keywords()
+{
+    if (!isValid())
+        return {};
+
+    warmUpKeywords();
+
+    QMutexLocker locker(&m_introspection->m_keywordsData->m_mutex);
+    return m_introspection->m_keywordsData->m_keywords;
+}
+
+void CMakeTool::warmUpKeywords()
+{
+    if (!m_introspection || m_introspection->m_didRequestKeywords)
+        return;
+    m_introspection->m_didRequestKeywords = true;
+
+    const std::shared_ptr<Internal::KeywordsData> data = m_introspection->m_keywordsData;
+    const QFuture<bool> future
+        = Utils::asyncRun(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                          loadKeywords,
+                          data,
+                          cmakeExecutable());
+    ExtensionSystem::PluginManager::futureSynchronizer()->addFuture(future);
+
+    // Users of the keywords that came before them need to know when they are there
+    Utils::onResultReady(future, CMakeToolManager::instance(), [id = m_id, data](bool loaded) {
+        CMakeTool *tool = CMakeToolManager::findById(id);
+        if (!tool || !tool->m_introspection || tool->m_introspection->m_keywordsData != data)
+            return;
+        if (!loaded) {
+            // CMake could not be run, try again on the next request
+            tool->m_introspection->m_didRequestKeywords = false;
+            return;
+        }
+        emit CMakeToolManager::instance()->cmakeKeywordsLoaded(id);
+    });
 }
 
 bool CMakeTool::hasFileApi(bool ignoreCache) const
@@ -504,15 +741,15 @@ void CMakeTool::parseFunctionDetailsOutput(const QString &output)
                 QStringList words = parseDefinition(currentDefinition);
                 if (!words.isEmpty()) {
                     const QString command = words.takeFirst();
-                    if (m_introspection->m_keywords.functions.contains(command)) {
+                    if (m_introspection->m_keywordsData->m_keywords.functions.contains(command)) {
                         const QStringList tmp = Utils::sorted(
-                            words + m_introspection->m_keywords.functionArgs[command]);
-                        m_introspection->m_keywords.functionArgs[command] = Utils::filteredUnique(
+                            words + m_introspection->m_keywordsData->m_keywords.functionArgs[command]);
+                        m_introspection->m_keywordsData->m_keywords.functionArgs[command] = Utils::filteredUnique(
                             tmp);
                     }
                 }
-                if (!words.isEmpty() && m_introspection->m_keywords.functions.contains(words.at(0)))
-                    m_introspection->m_keywords.functionArgs[words.at(0)];
+                if (!words.isEmpty() && m_introspection->m_keywordsData->m_keywords.functions.contains(words.at(0)))
+                    m_introspection->m_keywordsData->m_keywords.functionArgs[words.at(0)];
                 currentDefinition.clear();
             } else {
                 currentDefinition.append(line.trimmed() + ' ');
@@ -550,84 +787,6 @@ QStringList CMakeTool::parseVariableOutput(const QString &output)
     return result;
 }
 
-QStringList CMakeTool::parseSyntaxHighlightingXml()
-{
-    QStringList moduleFunctions;
-
-    const FilePath cmakeXml = Core::ICore::resourcePath("generic-highlighter/syntax/cmake.xml");
-    QXmlStreamReader reader(cmakeXml.fileContents().value_or(QByteArray()));
-
-    auto readItemList = [](QXmlStreamReader &reader) -> QStringList {
-        QStringList arguments;
-        while (!reader.atEnd() && reader.readNextStartElement()) {
-            if (reader.name() == u"item")
-                arguments.append(reader.readElementText());
-            else
-                reader.skipCurrentElement();
-        }
-        return arguments;
-    };
-
-    while (!reader.atEnd() && reader.readNextStartElement()) {
-        if (reader.name() != u"highlighting")
-            continue;
-        while (!reader.atEnd() && reader.readNextStartElement()) {
-            if (reader.name() == u"list") {
-                const auto name = reader.attributes().value("name").toString();
-                if (name.endsWith(u"_sargs") || name.endsWith(u"_nargs")) {
-                    const auto functionName = name.left(name.length() - 6);
-                    QStringList arguments = readItemList(reader);
-
-                    if (m_introspection->m_keywords.functionArgs.contains(functionName))
-                        arguments.append(
-                            m_introspection->m_keywords.functionArgs.value(functionName));
-
-                    m_introspection->m_keywords.functionArgs[functionName] = arguments;
-
-                    // Functions that are part of CMake modules like ExternalProject_Add
-                    // which are not reported by cmake --help-list-commands
-                    if (!m_introspection->m_keywords.functions.contains(functionName)) {
-                        moduleFunctions << functionName;
-                    }
-                } else if (name == u"generator-expressions") {
-                    m_introspection->m_keywords.generatorExpressions = toSet(readItemList(reader));
-                } else {
-                    reader.skipCurrentElement();
-                }
-            } else {
-                reader.skipCurrentElement();
-            }
-        }
-    }
-
-    // Some commands have the same arguments as other commands and the `cmake.xml`
-    // but their relationship is weirdly defined in the `cmake.xml` file.
-    using ListStringPair = QList<QPair<QString, QString>>;
-    const ListStringPair functionPairs = {{"if", "elseif"},
-                                          {"while", "elseif"},
-                                          {"find_path", "find_file"},
-                                          {"find_program", "find_library"},
-                                          {"target_link_libraries", "target_compile_definitions"},
-                                          {"target_link_options", "target_compile_definitions"},
-                                          {"target_link_directories", "target_compile_options"},
-                                          {"set_target_properties", "set_directory_properties"},
-                                          {"set_tests_properties", "set_directory_properties"}};
-    for (const auto &pair : std::as_const(functionPairs)) {
-        if (!m_introspection->m_keywords.functionArgs.contains(pair.first))
-            m_introspection->m_keywords.functionArgs[pair.first]
-                = m_introspection->m_keywords.functionArgs.value(pair.second);
-    }
-
-    // Special case for cmake_print_variables, which will print the names and values for variables
-    // and needs to be as a known function
-    const QString cmakePrintVariables("cmake_print_variables");
-    m_introspection->m_keywords.functionArgs[cmakePrintVariables] = {};
-    moduleFunctions << cmakePrintVariables;
-
-    moduleFunctions.removeDuplicates();
-    return moduleFunctions;
-}
-
 void CMakeTool::fetchFromCapabilities(bool ignoreCache) const
 {
     expected_str<Utils::Store> cache = PersistentCacheStore::byKey(
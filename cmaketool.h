@@ -90,7 +90,11 @@ public:
     bool isAutoRun() const;
     bool autoCreateBuildDirectory() const;
     QList<Generator> supportedGenerators() const;
+    // The keywords are loaded in the background, empty until they are available. See
+    // CMakeToolManager::cmakeKeywordsLoaded().
     CMakeKeywords keywords();
+    // Starts loading the keywords, from the cache if the executable did not change
+    void warmUpKeywords();
     bool hasFileApi(bool ignoreCache = false) const;
     Version version() const;
     QString versionDisplay() const;
@@ -118,7 +122,6 @@ private:
     void runCMake(Utils::Process &proc, const QStringList &args, int timeoutS = 1) const;
     void parseFunctionDetailsOutput(const QString &output);
     QStringList parseVariableOutput(const QString &output);
-    QStringList parseSyntaxHighlightingXml();
 
     void fetchFromCapabilities(bool ignoreCache = false) const;
     void parseFromCapabilities(const QString &input) const;
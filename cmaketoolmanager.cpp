@@ -3,6 +3,7 @@
 
 #include "cmaketoolmanager.h"
 
+#include "cmakehelpindex.h"
 #include "cmakekitaspect.h"
 #include "cmakeprojectmanagertr.h"
 #include "cmakespecificsettings.h"
@@ -222,6 +223,7 @@ bool CMakeToolManager::registerCMakeTool(std::unique_ptr<CMakeTool> &&tool)
         return toolId == known->id();
     }), return false);
 
+    tool->warmUpKeywords();
     d->m_cmakeTools.emplace_back(std::move(tool));
 
     emit CMakeToolManager::m_instance->cmakeAdded(toolId);
@@ -237,6 +239,7 @@ void CMakeToolManager::deregisterCMakeTool(const Id &id)
 {
     auto toRemove = Utils::take(d->m_cmakeTools, Utils::equal(&CMakeTool::id, id));
     if (toRemove.has_value()) {
+        releaseHelpIndex((*toRemove)->filePath());
         ensureDefaultCMakeToolIsValid();
 
         updateDocumentation();
@@ -291,6 +294,9 @@ void CMakeToolManager::restoreCMakeTools()
     d->m_cmakeTools = std::move(tools.cmakeTools);
     setDefaultCMakeTool(tools.defaultToolId);
 
+    for (const auto &tool : std::as_const(d->m_cmakeTools))
+        tool->warmUpKeywords();
+
     updateDocumentation();
 
     emit m_instance->cmakeToolsLoaded();
@@ -318,6 +324,10 @@ void CMakeToolManager::updateDocumentation()
 
 QString CMakeToolManager::toolTipForRstHelpFile(const FilePath &helpFile)
 {
+    // The help files of the registered CMake tools are rendered in the background
+    if (const std::optional<QString> toolTip = Internal::CMakeHelpIndex::toolTip(helpFile))
+        return *toolTip;
+
     static QHash<FilePath, QString> map;
     static QMutex mutex;
     QMutexLocker locker(&mutex);
@@ -325,17 +335,23 @@ QString CMakeToolManager::toolTipForRstHelpFile(const FilePath &helpFile)
     if (map.contains(helpFile))
         return map.value(helpFile);
 
-    auto content = helpFile.fileContents(1024).value_or(QByteArray());
+    const QString tooltip = toolTipForRstHelpText(
+        helpFile.fileContents(1024).value_or(QByteArray()));
+
+    map[helpFile] = tooltip;
+    return tooltip;
+}
+
+QString CMakeToolManager::toolTipForRstHelpText(const QByteArray &text)
+{
+    QByteArray content = text.left(1024);
     content.replace("\r\n", "\n");
 
     HtmlHandler handler;
     rst::Parser parser(&handler);
     parser.Parse(content.left(content.lastIndexOf('\n')));
 
-    const QString tooltip = handler.content();
-
-    map[helpFile] = tooltip;
-    return tooltip;
+    return handler.content();
 }
 
 QList<Id> CMakeToolManager::autoDetectCMakeForDevice(const FilePaths &searchPaths,
@@ -386,6 +402,7 @@ void CMakeToolManager::removeDetectedCMake(const QString &detectionSource, QStri
         if (!toRemove.has_value())
             break;
         logMessages.append(Tr::tr("Removed \"%1\"").arg((*toRemove)->displayName()));
+        releaseHelpIndex((*toRemove)->filePath());
         emit m_instance->cmakeRemoved((*toRemove)->id());
     }
 
@@ -413,6 +430,15 @@ void CMakeToolManager::notifyAboutUpdate(CMakeTool *tool)
     emit m_instance->cmakeUpdated(tool->id());
 }
 
+void CMakeToolManager::releaseHelpIndex(const FilePath &executable)
+{
+    if (executable.isEmpty()
+        || Utils::contains(d->m_cmakeTools, Utils::equal(&CMakeTool::filePath, executable))) {
+        return;
+    }
+    Internal::CMakeHelpIndex::setIndex(executable, {});
+}
+
 void CMakeToolManager::saveCMakeTools()
 {
     d->m_accessor.saveCMakeTools(cmakeTools(), d->m_defaultCMake, ICore::dialogParent());
@@ -38,11 +38,15 @@ public:
     static CMakeTool *findById(const Utils::Id &id);
 
     static void notifyAboutUpdate(CMakeTool *);
+    // Drops the help index of an executable that no registered tool uses anymore
+    static void releaseHelpIndex(const Utils::FilePath &executable);
     static void restoreCMakeTools();
 
     static void updateDocumentation();
 
     static QString toolTipForRstHelpFile(const Utils::FilePath &helpFile);
+    // Renders the start of the content of a help file, without caching
+    static QString toolTipForRstHelpText(const QByteArray &text);
 
 public slots:
     QList<Utils::Id> autoDetectCMakeForDevice(const Utils::FilePaths &searchPaths,
@@ -57,6 +61,7 @@ signals:
     void cmakeAdded (const Utils::Id &id);
     void cmakeRemoved (const Utils::Id &id);
     void cmakeUpdated (const Utils::Id &id);
+    void cmakeKeywordsLoaded(const Utils::Id &id);
     void cmakeToolsChanged ();
     void cmakeToolsLoaded ();
     void defaultCMakeChanged ();
@@ -3,6 +3,7 @@
 
 #include "fileapidataextractor.h"
 
+#include "cmakeparsetimings.h"
 #include "cmakeprojectconstants.h"
 #include "cmakeprojectmanagertr.h"
 #include "cmakespecificsettings.h"
@@ -10,6 +11,7 @@
 #include "projecttreehelper.h"
 
 #include <cppeditor/cppeditorconstants.h>
+#include <cppeditor/projectfile.h>
 #include <cppeditor/projectinfo.h>
 
 #include <projectexplorer/projecttree.h>
@@ -24,6 +26,8 @@
 #include <QLoggingCategory>
 #include <QtConcurrent>
 
+#include <numeric>
+
 using namespace ProjectExplorer;
 using namespace Utils;
 using namespace CMakeProjectManager::Internal::FileApiDetails;
@@ -45,12 +49,82 @@ public:
     std::vector<std::unique_ptr<FileNode>> cmakeNodesBuild;
     std::vector<std::unique_ptr<FileNode>> cmakeNodesOther;
     std::vector<std::unique_ptr<FileNode>> cmakeListNodes;
+
+    std::shared_ptr<const CMakeFileCache> cmakeFileCache;
+};
+
+static CMakeFileResult cmakeFileNodes(const QFuture<void> &cancelFuture,
+                                      const QList<CMakeFileInfo> &cmakeFiles,
+                                      const FilePath &sourceDirectory,
+                                      const FilePath &buildDirectory)
+{
+    CMakeFileResult result;
+
+    for (const auto &info : cmakeFiles) {
+        if (cancelFuture.isCanceled())
+            return {};
+
+        result.cmakeFiles.insert(info);
+
+        if (info.isCMake && !info.isCMakeListsDotTxt) {
+            // Skip files that cmake considers to be part of the installation -- but include
+            // CMakeLists.txt files. This fixes cmake binaries running from their own
+            // build directory.
+            continue;
+        }
+
+        auto node = std::make_unique<FileNode>(info.path, FileType::Project);
+        node->setIsGenerated(info.isGenerated
+                             && !info.isCMakeListsDotTxt); // CMakeLists.txt are never
+                                                           // generated, independent
+                                                           // what cmake thinks:-)
+
+        if (info.isCMakeListsDotTxt) {
+            result.cmakeListNodes.emplace_back(std::move(node));
+        } else if (info.path.isChildOf(sourceDirectory)) {
+            result.cmakeNodesSource.emplace_back(std::move(node));
+        } else if (info.path.isChildOf(buildDirectory)) {
+            result.cmakeNodesBuild.emplace_back(std::move(node));
+        } else {
+            result.cmakeNodesOther.emplace_back(std::move(node));
+        }
+    }
+
+    return result;
+}
+
+class ParsedCMakeFile
+{
+public:
+    CMakeFileInfo info;
+    std::optional<CMakeFileCache::Entry> cacheEntry; // Set for parsed files
 };
 
+// Returns the cache entry of the file, nothing if it could not be read
+static std::optional<CMakeFileCache::Entry> parseCMakeFile(const FilePath &filePath,
+                                                           const FilePathInfo &fileInfo,
+                                                           cmListFile &cmakeListFile)
+{
+    expected_str<QByteArray> fileContent = filePath.fileContents();
+    if (!fileContent)
+        return {};
+
+    std::string errorString;
+    fileContent = fileContent->replace("\r\n", "\n");
+    if (!cmakeListFile.ParseString(fileContent->toStdString(),
+                                   filePath.fileName().toStdString(),
+                                   errorString)) {
+        qCWarning(cmakeLogger) << "Failed to parse:" << filePath.path()
+                               << QString::fromLatin1(errorString);
+    }
+    return CMakeFileCache::Entry{fileInfo.lastModified, fileInfo.fileSize, cmakeListFile};
+}
+
 static CMakeFileResult extractCMakeFilesData(const QFuture<void> &cancelFuture,
                                              const std::vector<CMakeFileInfo> &cmakefiles,
                                              const FilePath &sourceDirectory,
-                                             const FilePath &buildDirectory)
+                                             const FilePath &buildDirectory,
+                                             const std::shared_ptr<const CMakeFileCache> &cache)
 {
     if (cmakefiles.empty())
         return {};
@@ -60,31 +134,39 @@ static CMakeFileResult extractCMakeFilesData(const QFuture<void> &cancelFuture,
 
     // Load and parse cmake files. We use concurrency here to speed up the process of
     // reading many small files, which can get slow especially on remote devices.
-    QFuture<CMakeFileInfo> mapResult
-        = QtConcurrent::mapped(cmakeFileSet, [cancelFuture, sourceDirectory](const auto &info) {
+    // Files that did not change since the last parse are taken from the cache.
+    QFuture<ParsedCMakeFile> mapResult
+        = QtConcurrent::mapped(cmakeFileSet,
+                               [cancelFuture, sourceDirectory, cache](const auto &info) {
+              ParsedCMakeFile result;
               if (cancelFuture.isCanceled())
-                  return CMakeFileInfo();
+                  return result;
               const FilePath sfn = sourceDirectory.resolvePath(info.path);
-              CMakeFileInfo absolute(info);
+              CMakeFileInfo &absolute = result.info;
+              absolute = info;
               absolute.path = sfn;
 
               const auto mimeType = Utils::mimeTypeForFile(info.path);
               if (mimeType.matchesName(Utils::Constants::CMAKE_MIMETYPE)
                   || mimeType.matchesName(Utils::Constants::CMAKE_PROJECT_MIMETYPE)) {
-                  expected_str<QByteArray> fileContent = sfn.fileContents();
-                  std::string errorString;
-                  if (fileContent) {
-                      fileContent = fileContent->replace("\r\n", "\n");
-                      if (!absolute.cmakeListFile.ParseString(fileContent->toStdString(),
-                                                              sfn.fileName().toStdString(),
-                                                              errorString)) {
-                          qCWarning(cmakeLogger) << "Failed to parse:" << sfn.path()
-                                                 << QString::fromLatin1(errorString);
+                  const FilePathInfo fileInfo = sfn.filePathInfo();
+                  absolute.lastModified = fileInfo.lastModified;
+                  absolute.size = fileInfo.fileSize;
+                  if (cache) {
+                      const auto cached = cache->files.constFind(sfn);
+                      if (cached != cache->files.constEnd()
+                          && cached->lastModified == fileInfo.lastModified
+                          && cached->size == fileInfo.fileSize) {
+                          absolute.cmakeListFile = cached->cmakeListFile;
+                          result.cacheEntry = *cached;
+                          return result;
                       }
                   }
+
+                  result.cacheEntry = parseCMakeFile(sfn, fileInfo, absolute.cmakeListFile);
               }
 
-              return absolute;
+              return result;
           });
 
     mapResult.waitForFinished();
@@ -92,40 +174,45 @@ static CMakeFileResult extractCMakeFilesData(const QFuture<void> &cancelFuture,
     if (cancelFuture.isCanceled())
         return {};
 
-    CMakeFileResult result;
-
-    for (const auto &info : mapResult.results()) {
-        if (cancelFuture.isCanceled())
-            return {};
+    // The new cache only keeps the files of this parse:
+    auto newCache = std::make_shared<CMakeFileCache>();
+    QList<CMakeFileInfo> infos;
+    const QList<ParsedCMakeFile> parsedFiles = mapResult.results();
+    infos.reserve(parsedFiles.size());
+    for (const ParsedCMakeFile &file : parsedFiles) {
+        infos.append(file.info);
+        if (file.cacheEntry)
+            newCache->files.insert(file.info.path, *file.cacheEntry);
+    }
 
-        result.cmakeFiles.insert(info);
+    CMakeFileResult result = cmakeFileNodes(cancelFuture, infos, sourceDirectory, buildDirectory);
+    result.cmakeFileCache = std::move(newCache);
+    return result;
+}
 
-        if (info.isCMake && !info.isCMakeListsDotTxt) {
-            // Skip files that cmake considers to be part of the installation -- but include
-            // CMakeLists.txt files. This fixes cmake binaries running from their own
-            // build directory.
-            continue;
-        }
+// What the extractor needs to know about a source file of a target. Targets share many of
+// their files, headers in particular, so each path is classified once per parse.
+class SourceClassification
+{
+public:
+    FilePath path; // Resolved against the top level source directory
+    FileType fileType = FileType::Unknown;
+    CppEditor::ProjectFile::Kind kind = CppEditor::ProjectFile::Unsupported;
+    QString mimeType;
+    bool isAmbiguousHeader = false;
+    bool isPchFile = false;
+    bool isUnityFile = false;
+};
 
-        auto node = std::make_unique<FileNode>(info.path, FileType::Project);
-        node->setIsGenerated(info.isGenerated
-                             && !info.isCMakeListsDotTxt); // CMakeLists.txt are never
-                                                           // generated, independent
-                                                           // what cmake thinks:-)
+using SourceClassifications = QHash<QString, SourceClassification>; // Keyed by SourceInfo::path
 
-        if (info.isCMakeListsDotTxt) {
-            result.cmakeListNodes.emplace_back(std::move(node));
-        } else if (info.path.isChildOf(sourceDirectory)) {
-            result.cmakeNodesSource.emplace_back(std::move(node));
-        } else if (info.path.isChildOf(buildDirectory)) {
-            result.cmakeNodesBuild.emplace_back(std::move(node));
-        } else {
-            result.cmakeNodesOther.emplace_back(std::move(node));
-        }
-    }
+// The mime types of the classified files, shared by the project parts of all targets. Keyed by
+// the file system path. Ambiguous headers map to an empty string, their mime type depends on
+// the language of the compile group.
+using SourceMimeTypes = QHash<QString, QString>;
 
-    return result;
-}
+// From a CMake PCH header to the copy the code model uses instead
+using PchCopies = QList<std::pair<FilePath, FilePath>>;
 
 class PreprocessedData
 {
@@ -138,9 +225,15 @@ public:
     std::vector<std::unique_ptr<FileNode>> cmakeNodesBuild;
     std::vector<std::unique_ptr<FileNode>> cmakeNodesOther;
     std::vector<std::unique_ptr<FileNode>> cmakeListNodes;
+    std::shared_ptr<const CMakeFileCache> cmakeFileCache;
 
     Configuration codemodel;
     std::vector<TargetDetails> targetDetails;
+    QStringList targetFiles;
+    SourceClassifications sourceClassifications;
+    std::shared_ptr<const SourceMimeTypes> sourceMimeTypes;
+    const FileApiTargetCache *targetCache = nullptr;
+    const FileApiReplyCache *replyCache = nullptr;
 };
 
 static PreprocessedData preprocess(const QFuture<void> &cancelFuture, FileApiData &data,
@@ -152,20 +245,32 @@ static PreprocessedData preprocess(const QFuture<void> &cancelFuture, FileApiDat
 
     result.codemodel = std::move(data.codemodel);
 
+    ParseTimings::Phase phase(data.timings, "extractCMakeFilesData");
+    phase.setCount(qsizetype(data.cmakeFiles.size()));
     CMakeFileResult cmakeFileResult = extractCMakeFilesData(cancelFuture, data.cmakeFiles,
-                                                            sourceDirectory, buildDirectory);
+                                                            sourceDirectory, buildDirectory,
+                                                            data.cmakeFileCache);
 
     result.cmakeFiles = std::move(cmakeFileResult.cmakeFiles);
     result.cmakeNodesSource = std::move(cmakeFileResult.cmakeNodesSource);
     result.cmakeNodesBuild = std::move(cmakeFileResult.cmakeNodesBuild);
     result.cmakeNodesOther = std::move(cmakeFileResult.cmakeNodesOther);
     result.cmakeListNodes = std::move(cmakeFileResult.cmakeListNodes);
+    result.cmakeFileCache = std::move(cmakeFileResult.cmakeFileCache);
 
     result.targetDetails = std::move(data.targetDetails);
+    result.targetFiles = std::move(data.targetFiles);
 
     return result;
 }
 
+static const CachedTarget *cachedTarget(const PreprocessedData &input, size_t index)
+{
+    if (!input.targetCache || index >= size_t(input.targetFiles.size()))
+        return nullptr;
+    return input.targetCache->targets.value(input.targetFiles.at(index)).get();
+}
+
 static QVector<FolderNode::LocationInfo> extractBacktraceInformation(
     const BacktraceInfo &backtraces,
     const FilePath &sourceDir,
@@ -207,6 +312,71 @@ static bool isChildOf(const FilePath &path, const FilePaths &prefixes)
     return false;
 }
 
+static FilePaths extractLibraryDirectories(const TargetDetails &t,
+                                           const FilePath &buildDirectory,
+                                           bool relativeLibs)
+{
+    const FilePath currentBuildDir = buildDirectory.resolvePath(t.buildDir);
+
+    FilePaths librarySeachPaths;
+    // Extract library directories for executables:
+    for (const FragmentInfo &f : t.link.value().fragments) {
+        if (f.role == "flags") // ignore all flags fragments
+            continue;
+
+        // CMake sometimes mixes several shell-escaped pieces into one fragment. Disentangle that again:
+        const QStringList parts = ProcessArgs::splitArgs(f.fragment, HostOsInfo::hostOs());
+        for (QString part : parts) {
+            // Library search paths that are added with target_link_directories are added as
+            // -LIBPATH:... (Windows/MSVC), or
+            // -L... (Unix/GCC)
+            // with role "libraryPath"
+            if (f.role == "libraryPath") {
+                if (part.startsWith("-LIBPATH:"))
+                    part = part.mid(9);
+                else if (part.startsWith("-L"))
+                    part = part.mid(2);
+            }
+
+            // Some projects abuse linking to libraries to pass random flags to the linker, so ignore
+            // flags mixed into a fragment
+            if (part.startsWith("-"))
+                continue;
+
+            const FilePath buildDir = relativeLibs ? buildDirectory : currentBuildDir;
+            FilePath tmp = buildDir.resolvePath(part);
+
+            if (f.role == "libraries")
+                tmp = tmp.parentDir();
+
+            if (!tmp.isEmpty() && tmp.isDir()) {
+                // f.role is libraryPath or frameworkPath
+                // On *nix, exclude sub-paths from "/lib(64)", "/usr/lib(64)" and
+                // "/usr/local/lib" since these are usually in the standard search
+                // paths. There probably are more, but the naming schemes are arbitrary
+                // so we'd need to ask the linker ("ld --verbose | grep SEARCH_DIR").
+                if (buildDir.osType() == OsTypeWindows
+                    || !isChildOf(tmp,
+                                  {"/lib",
+                                   "/lib64",
+                                   "/usr/lib",
+                                   "/usr/lib64",
+                                   "/usr/local/lib"})) {
+                    librarySeachPaths.append(tmp);
+                    // Libraries often have their import libs in ../lib and the
+                    // actual dll files in ../bin on windows. Qt is one example of that.
+                    if (tmp.fileName() == "lib" && buildDir.osType() == OsTypeWindows) {
+                        const FilePath path = tmp.parentDir().pathAppended("bin");
+                        if (path.isDir())
+                            librarySeachPaths.append(path);
+                    }
+                }
+            }
+        }
+    }
+    return filteredUnique(librarySeachPaths);
+}
+
 static CMakeBuildTarget toBuildTarget(const TargetDetails &t,
                                       const FilePath &sourceDirectory,
                                       const FilePath &buildDirectory,
@@ -261,7 +431,6 @@ static CMakeBuildTarget toBuildTarget(const TargetDetails &t,
     }
 
     if (ct.targetType == ExecutableType) {
-        FilePaths librarySeachPaths;
         // Is this a GUI application?
         ct.linksToQtGui = Utils::contains(t.link.value().fragments,
                                           [](const FragmentInfo &f) {
@@ -273,62 +442,7 @@ static CMakeBuildTarget toBuildTarget(const TargetDetails &t,
 
         ct.qtcRunnable = t.folderTargetProperty == "qtc_runnable";
 
-        // Extract library directories for executables:
-        for (const FragmentInfo &f : t.link.value().fragments) {
-            if (f.role == "flags") // ignore all flags fragments
-                continue;
-
-            // CMake sometimes mixes several shell-escaped pieces into one fragment. Disentangle that again:
-            const QStringList parts = ProcessArgs::splitArgs(f.fragment, HostOsInfo::hostOs());
-            for (QString part : parts) {
-                // Library search paths that are added with target_link_directories are added as
-                // -LIBPATH:... (Windows/MSVC), or
-                // -L... (Unix/GCC)
-                // with role "libraryPath"
-                if (f.role == "libraryPath") {
-                    if (part.startsWith("-LIBPATH:"))
-                        part = part.mid(9);
-                    else if (part.startsWith("-L"))
-                        part = part.mid(2);
-                }
-
-                // Some projects abuse linking to libraries to pass random flags to the linker, so ignore
-                // flags mixed into a fragment
-                if (part.startsWith("-"))
-                    continue;
-
-                const FilePath buildDir = relativeLibs ? buildDirectory : currentBuildDir;
-                FilePath tmp = buildDir.resolvePath(part);
-
-                if (f.role == "libraries")
-                    tmp = tmp.parentDir();
-
-                if (!tmp.isEmpty() && tmp.isDir()) {
-                    // f.role is libraryPath or frameworkPath
-                    // On *nix, exclude sub-paths from "/lib(64)", "/usr/lib(64)" and
-                    // "/usr/local/lib" since these are usually in the standard search
-                    // paths. There probably are more, but the naming schemes are arbitrary
-                    // so we'd need to ask the linker ("ld --verbose | grep SEARCH_DIR").
-                    if (buildDir.osType() == OsTypeWindows
-                        || !isChildOf(tmp,
-                                      {"/lib",
-                                       "/lib64",
-                                       "/usr/lib",
-                                       "/usr/lib64",
-                                       "/usr/local/lib"})) {
-                        librarySeachPaths.append(tmp);
-                        // Libraries often have their import libs in ../lib and the
-                        // actual dll files in ../bin on windows. Qt is one example of that.
-                        if (tmp.fileName() == "lib" && buildDir.osType() == OsTypeWindows) {
-                            const FilePath path = tmp.parentDir().pathAppended("bin");
-                            if (path.isDir())
-                                librarySeachPaths.append(path);
-                        }
-                    }
-                }
-            }
-        }
-        ct.libraryDirectories = filteredUnique(librarySeachPaths);
+        ct.libraryDirectories = extractLibraryDirectories(t, buildDirectory, relativeLibs);
     }
     return ct;
 }
@@ -339,12 +453,25 @@ static QList<CMakeBuildTarget> generateBuildTargets(const QFuture<void> &cancelF
                                                     const FilePath &buildDirectory,
                                                     bool relativeLibs)
 {
+    const bool useCache = input.targetCache && input.targetCache->relativeLibs == relativeLibs;
+
     QList<CMakeBuildTarget> result;
     result.reserve(input.targetDetails.size());
-    for (const TargetDetails &t : input.targetDetails) {
+    for (size_t i = 0; i < input.targetDetails.size(); ++i) {
         if (cancelFuture.isCanceled())
             return {};
-        result.append(toBuildTarget(t, sourceDirectory, buildDirectory, relativeLibs));
+        const TargetDetails &t = input.targetDetails[i];
+        const CachedTarget *cached = useCache ? cachedTarget(input, i) : nullptr;
+        if (!cached) {
+            result.append(toBuildTarget(t, sourceDirectory, buildDirectory, relativeLibs));
+            continue;
+        }
+
+        // The library directories depend on the state of the file system, so update them:
+        CMakeBuildTarget ct = cached->buildTarget;
+        if (ct.targetType == ExecutableType)
+            ct.libraryDirectories = extractLibraryDirectories(t, buildDirectory, relativeLibs);
+        result.append(ct);
     }
     return result;
 }
@@ -369,181 +496,402 @@ static bool isUnityFile(const FilePath &buildDirectory, const FilePath &path)
            && path.parentDir().fileName() == "Unity";
 }
 
-static RawProjectParts generateRawProjectParts(const QFuture<void> &cancelFuture,
-                                               const PreprocessedData &input,
+static SourceClassification classifySource(const QString &sourcePath,
+                                           const FilePath &sourceDirectory,
+                                           const FilePath &buildDirectory)
+{
+    SourceClassification result;
+    result.path = sourceDirectory.resolvePath(sourcePath);
+    result.fileType = Node::fileTypeForFileName(result.path);
+    result.kind = CppEditor::ProjectFile::classify(sourcePath);
+    result.mimeType = Utils::mimeTypeForFile(result.path.toFSPathString()).name();
+    result.isAmbiguousHeader
+        = CppEditor::ProjectFile::isAmbiguousHeader(result.path.toFSPathString());
+    result.isPchFile = isPchFile(buildDirectory, result.path);
+    result.isUnityFile = isUnityFile(buildDirectory, result.path);
+    return result;
+}
+
+// Only the targets without cached project parts need their sources classified. The project
+// tree falls back to the cheap parts of the classification for the other ones.
+static SourceClassifications classifySources(const QFuture<void> &cancelFuture,
+                                             const PreprocessedData &input,
+                                             const FilePath &sourceDirectory,
+                                             const FilePath &buildDirectory)
+{
+    QSet<QString> knownPaths;
+    QStringList paths;
+    for (size_t i = 0; i < input.targetDetails.size(); ++i) {
+        const CachedTarget *cached = cachedTarget(input, i);
+        if (cached && cached->projectParts)
+            continue;
+        const TargetDetails &t = input.targetDetails[i];
+        for (const SourceInfo &si : t.sources) {
+            const int count = knownPaths.count();
+            knownPaths.insert(si.path);
+            if (count != knownPaths.count())
+                paths.append(si.path);
+        }
+    }
+
+    // The mime type lookups are the expensive part, so they run concurrently:
+    QFuture<SourceClassification> mapResult
+        = QtConcurrent::mapped(paths,
+                               [&cancelFuture, &sourceDirectory, &buildDirectory](const QString &path) {
+              if (cancelFuture.isCanceled())
+                  return SourceClassification();
+              return classifySource(path, sourceDirectory, buildDirectory);
+          });
+    mapResult.waitForFinished();
+
+    if (cancelFuture.isCanceled())
+        return {};
+
+    SourceClassifications result;
+    result.reserve(paths.size());
+    for (int i = 0; i < paths.size(); ++i)
+        result.insert(paths.at(i), mapResult.resultAt(i));
+    return result;
+}
+
+static std::shared_ptr<const SourceMimeTypes> sourceMimeTypes(
+    const SourceClassifications &classifications)
+{
+    auto result = std::make_shared<SourceMimeTypes>();
+    result->reserve(classifications.size());
+    for (const SourceClassification &source : classifications) {
+        result->insert(source.path.toFSPathString(),
+                       source.isAmbiguousHeader ? QString() : source.mimeType);
+    }
+    return result;
+}
+
+// Falls back to classifying the file when it is not known yet. Only reads from the
+// classifications, so it can be used from several threads.
+static SourceClassification sourceClassification(const SourceClassifications &classifications,
+                                                 const QString &sourcePath,
+                                                 const FilePath &sourceDirectory,
+                                                 const FilePath &buildDirectory)
+{
+    const auto it = classifications.constFind(sourcePath);
+    if (it != classifications.constEnd())
+        return *it;
+    return classifySource(sourcePath, sourceDirectory, buildDirectory);
+}
+
+static RawProjectParts generateRawProjectParts(const TargetDetails &t,
                                                const FilePath &sourceDirectory,
-                                               const FilePath &buildDirectory)
+                                               const FilePath &buildDirectory,
+                                               const SourceClassifications &classifications,
+                                               const std::shared_ptr<const SourceMimeTypes> &mimeTypes,
+                                               PchCopies *pchCopies)
 {
     RawProjectParts rpps;
 
-    for (const TargetDetails &t : input.targetDetails) {
-        if (cancelFuture.isCanceled())
-            return {};
+    const auto classification = [&](const QString &sourcePath) {
+        return sourceClassification(classifications, sourcePath, sourceDirectory, buildDirectory);
+    };
+
+    bool needPostfix = t.compileGroups.size() > 1;
+    int count = 1;
+    for (const CompileInfo &ci : t.compileGroups) {
+        if (ci.language != "C" && ci.language != "CXX" && ci.language != "CUDA")
+            continue; // No need to bother the C++ codemodel
+
+        // CMake users worked around Creator's inability of listing header files by creating
+        // custom targets with all the header files. This target breaks the code model, so
+        // keep quiet about it:-)
+        if (ci.defines.empty() && ci.includes.empty()
+            && allOf(ci.sources, [&t, &classification](const int sid) {
+                   const SourceInfo &source = t.sources[static_cast<size_t>(sid)];
+                   return classification(source.path).fileType == FileType::Header;
+               })) {
+            qWarning() << "Not reporting all-header compilegroup of target" << t.name
+                       << "to code model.";
+            continue;
+        }
+
+        QString ending;
+        QString qtcPchFile;
+        if (ci.language == "C") {
+            ending = "/cmake_pch.h";
+            qtcPchFile = "qtc_cmake_pch.h";
+        }
+        else if (ci.language == "CXX") {
+            ending = "/cmake_pch.hxx";
+            qtcPchFile = "qtc_cmake_pch.hxx";
+        }
 
-        bool needPostfix = t.compileGroups.size() > 1;
-        int count = 1;
-        for (const CompileInfo &ci : t.compileGroups) {
-            if (ci.language != "C" && ci.language != "CXX" && ci.language != "CUDA")
-                continue; // No need to bother the C++ codemodel
-
-            // CMake users worked around Creator's inability of listing header files by creating
-            // custom targets with all the header files. This target breaks the code model, so
-            // keep quiet about it:-)
-            if (ci.defines.empty() && ci.includes.empty() && allOf(ci.sources, [&t](const int sid) {
-                    const SourceInfo &source = t.sources[static_cast<size_t>(sid)];
-                    return Node::fileTypeForFileName(FilePath::fromString(source.path))
-                           == FileType::Header;
-                })) {
-                qWarning() << "Not reporting all-header compilegroup of target" << t.name
-                           << "to code model.";
+        RawProjectPart rpp;
+        rpp.setProjectFileLocation(t.sourceDir.pathAppended("CMakeLists.txt").toString());
+        rpp.setBuildSystemTarget(t.name);
+        const QString postfix = needPostfix ? QString("_%1_%2").arg(ci.language).arg(count)
+                                            : QString();
+        rpp.setDisplayName(t.id + postfix);
+        rpp.setMacros(transform<QVector>(ci.defines, &DefineInfo::define));
+        rpp.setHeaderPaths(transform<QVector>(ci.includes, &IncludeInfo::path));
+
+        QStringList fragments = splitFragments(ci.fragments);
+
+        // Get all sources from the compiler group, except generated sources
+        QList<SourceClassification> sources;
+
+        for (auto idx: ci.sources) {
+            const SourceInfo &si = t.sources.at(idx);
+            if (si.isGenerated)
                 continue;
-            }
+            sources.append(classification(si.path));
+        }
+
+        // Skip groups with only generated source files e.g. <build-dir>/.rcc/qrc_<target>.cpp
+        if (allOf(ci.sources, [&t](const auto &idx) { return t.sources.at(idx).isGenerated; }))
+            continue;
+
+        // If we are not in a pch compiler group, add all the headers that are not generated
+        const bool hasPchSource = anyOf(sources, [](const SourceClassification &source) {
+            return source.isPchFile;
+        });
 
-            QString ending;
-            QString qtcPchFile;
+        const bool hasUnitySources = allOf(sources, [](const SourceClassification &source) {
+            return source.isUnityFile;
+        });
+
+        const QString headerMimeType = [&]() -> QString {
             if (ci.language == "C") {
-                ending = "/cmake_pch.h";
-                qtcPchFile = "qtc_cmake_pch.h";
-            }
-            else if (ci.language == "CXX") {
-                ending = "/cmake_pch.hxx";
-                qtcPchFile = "qtc_cmake_pch.hxx";
+                return Utils::Constants::C_HEADER_MIMETYPE;
+            } else if (ci.language == "CXX") {
+                return Utils::Constants::CPP_HEADER_MIMETYPE;
             }
+            return {};
+        }();
 
-            RawProjectPart rpp;
-            rpp.setProjectFileLocation(t.sourceDir.pathAppended("CMakeLists.txt").toString());
-            rpp.setBuildSystemTarget(t.name);
-            const QString postfix = needPostfix ? QString("_%1_%2").arg(ci.language).arg(count)
-                                                : QString();
-            rpp.setDisplayName(t.id + postfix);
-            rpp.setMacros(transform<QVector>(ci.defines, &DefineInfo::define));
-            rpp.setHeaderPaths(transform<QVector>(ci.includes, &IncludeInfo::path));
+        auto haveFileKindForLanguage = [&](const auto &kind) {
+            if (kind == CppEditor::ProjectFile::AmbiguousHeader)
+                return true;
 
-            QStringList fragments = splitFragments(ci.fragments);
+            if (ci.language == "C")
+                return CppEditor::ProjectFile::isC(kind);
+            else if (ci.language == "CXX")
+                return CppEditor::ProjectFile::isCxx(kind);
 
-            // Get all sources from the compiler group, except generated sources
-            FilePaths sources;
+            return false;
+        };
 
-            for (auto idx: ci.sources) {
-                SourceInfo si = t.sources.at(idx);
+        if (!hasPchSource) {
+            for (const SourceInfo &si : t.sources) {
                 if (si.isGenerated)
                     continue;
-                sources.append(sourceDirectory.resolvePath(si.path));
+
+                SourceClassification source = classification(si.path);
+                const auto kind = source.kind;
+                const bool headerType = CppEditor::ProjectFile::isHeader(kind)
+                                        && haveFileKindForLanguage(kind);
+                const bool sourceUnityType = hasUnitySources
+                                                 ? CppEditor::ProjectFile::isSource(kind)
+                                                       && haveFileKindForLanguage(kind)
+                                                 : false;
+                if (headerType || sourceUnityType)
+                    sources.append(std::move(source));
             }
+        }
 
-            // Skip groups with only generated source files e.g. <build-dir>/.rcc/qrc_<target>.cpp
-            if (allOf(ci.sources, [&t](const auto &idx) { return t.sources.at(idx).isGenerated; }))
+        // Set project files except duplicates and pch / unity files
+        QSet<FilePath> alreadyListed;
+        QStringList files;
+        for (const SourceClassification &source : std::as_const(sources)) {
+            if (source.isPchFile || source.isUnityFile)
+                continue;
+            const int count = alreadyListed.count();
+            alreadyListed.insert(source.path);
+            if (count == alreadyListed.count())
                 continue;
+            files.append(source.path.toFSPathString());
+        }
+
+        rpp.setFiles(files, {}, [mimeTypes, headerMimeType](const QString &path) {
+            if (mimeTypes) {
+                const auto it = mimeTypes->constFind(path);
+                if (it != mimeTypes->constEnd())
+                    return it->isEmpty() ? headerMimeType : *it;
+            }
+            if (CppEditor::ProjectFile::isAmbiguousHeader(path))
+                return headerMimeType;
+            return Utils::mimeTypeForFile(path).name();
+        });
+
+        FilePath precompiled_header
+            = FilePath::fromString(findOrDefault(t.sources, [&ending](const SourceInfo &si) {
+                                       return si.path.endsWith(ending);
+                                   }).path);
+        if (!precompiled_header.isEmpty()) {
+            precompiled_header = sourceDirectory.resolvePath(precompiled_header);
+
+            // Remove the CMake PCH usage command line options in order to avoid the case
+            // when the build system would produce a .pch/.gch file that would be treated
+            // by the Clang code model as its own and fail.
+            auto remove = [&](const QStringList &args) {
+                auto foundPos = std::search(fragments.begin(), fragments.end(),
+                                            args.begin(), args.end());
+                if (foundPos != fragments.end())
+                    fragments.erase(foundPos, std::next(foundPos, args.size()));
+            };
 
-            // If we are not in a pch compiler group, add all the headers that are not generated
-            const bool hasPchSource = anyOf(sources, [buildDirectory](const FilePath &path) {
-                return isPchFile(buildDirectory, path);
-            });
+            remove({"-Xclang", "-include-pch", "-Xclang", precompiled_header.path() + ".gch"});
+            remove({"-Xclang", "-include-pch", "-Xclang", precompiled_header.path() + ".pch"});
+            remove({"-Xclang", "-include", "-Xclang", precompiled_header.path()});
+            remove({"-include", precompiled_header.path()});
+            remove({"/FI", precompiled_header.path()});
 
-            const bool hasUnitySources = allOf(sources, [buildDirectory](const FilePath &path) {
-                return isUnityFile(buildDirectory, path);
-            });
+            // Make a copy of the CMake PCH header and use it instead. Targets can share the
+            // header, so the caller makes the copies.
+            FilePath qtc_precompiled_header = precompiled_header.parentDir().pathAppended(qtcPchFile);
+            pchCopies->append({precompiled_header, qtc_precompiled_header});
 
-            const QString headerMimeType = [&]() -> QString {
-                if (ci.language == "C") {
-                    return Utils::Constants::C_HEADER_MIMETYPE;
-                } else if (ci.language == "CXX") {
-                    return Utils::Constants::CPP_HEADER_MIMETYPE;
-                }
-                return {};
-            }();
+            rpp.setPreCompiledHeaders({qtc_precompiled_header.path()});
+        }
 
-            auto haveFileKindForLanguage = [&](const auto &kind) {
-                if (kind == CppEditor::ProjectFile::AmbiguousHeader)
-                    return true;
+        RawProjectPartFlags projectFlags;
+        projectFlags.commandLineFlags = fragments;
+        if (ci.language == "C")
+            rpp.setFlagsForC(projectFlags);
+        else if (ci.language == "CXX")
+            rpp.setFlagsForCxx(projectFlags);
+
+        const bool isExecutable = t.type == "EXECUTABLE";
+        rpp.setBuildTargetType(isExecutable ? BuildTargetType::Executable
+                                            : BuildTargetType::Library);
+        rpps.append(rpp);
+        ++count;
+    }
 
-                if (ci.language == "C")
-                    return CppEditor::ProjectFile::isC(kind);
-                else if (ci.language == "CXX")
-                    return CppEditor::ProjectFile::isCxx(kind);
+    return rpps;
+}
 
-                return false;
-            };
+static std::vector<RawProjectParts> generateRawProjectParts(const QFuture<void> &cancelFuture,
+                                                            const PreprocessedData &input,
+                                                            const FilePath &sourceDirectory,
+                                                            const FilePath &buildDirectory,
+                                                            FileApiStringPool &stringPool,
+                                                            std::vector<bool> *cacheable)
+{
+    class TargetParts
+    {
+    public:
+        RawProjectParts rpps;
+        PchCopies pchCopies;
+        bool cacheable = true;
+        bool cached = false;
+    };
 
-            if (!hasPchSource) {
-                for (const SourceInfo &si : t.sources) {
-                    if (si.isGenerated)
-                        continue;
-
-                    const auto kind = CppEditor::ProjectFile::classify(si.path);
-                    const bool headerType = CppEditor::ProjectFile::isHeader(kind)
-                                            && haveFileKindForLanguage(kind);
-                    const bool sourceUnityType = hasUnitySources
-                                                     ? CppEditor::ProjectFile::isSource(kind)
-                                                           && haveFileKindForLanguage(kind)
-                                                     : false;
-                    if (headerType || sourceUnityType)
-                        sources.append(sourceDirectory.resolvePath(si.path));
-                }
-            }
-            FilePath::removeDuplicates(sources);
-
-            // Set project files except pch / unity files
-            const FilePaths filtered = Utils::filtered(sources,
-                                         [buildDirectory](const FilePath &filePath) {
-                                             return !isPchFile(buildDirectory, filePath)
-                                                 && !isUnityFile(buildDirectory, filePath);
-                                         });
-
-            rpp.setFiles(Utils::transform(filtered, &FilePath::toFSPathString),
-                         {},
-                         [headerMimeType](const QString &path) {
-                             if (CppEditor::ProjectFile::isAmbiguousHeader(path))
-                                 return headerMimeType;
-                             return Utils::mimeTypeForFile(path).name();
-                         });
-
-            FilePath precompiled_header
-                = FilePath::fromString(findOrDefault(t.sources, [&ending](const SourceInfo &si) {
-                                           return si.path.endsWith(ending);
-                                       }).path);
-            if (!precompiled_header.isEmpty()) {
-                precompiled_header = sourceDirectory.resolvePath(precompiled_header);
-
-                // Remove the CMake PCH usage command line options in order to avoid the case
-                // when the build system would produce a .pch/.gch file that would be treated
-                // by the Clang code model as its own and fail.
-                auto remove = [&](const QStringList &args) {
-                    auto foundPos = std::search(fragments.begin(), fragments.end(),
-                                                args.begin(), args.end());
-                    if (foundPos != fragments.end())
-                        fragments.erase(foundPos, std::next(foundPos, args.size()));
-                };
-
-                remove({"-Xclang", "-include-pch", "-Xclang", precompiled_header.path() + ".gch"});
-                remove({"-Xclang", "-include-pch", "-Xclang", precompiled_header.path() + ".pch"});
-                remove({"-Xclang", "-include", "-Xclang", precompiled_header.path()});
-                remove({"-include", precompiled_header.path()});
-                remove({"/FI", precompiled_header.path()});
-
-                // Make a copy of the CMake PCH header and use it instead
-                FilePath qtc_precompiled_header = precompiled_header.parentDir().pathAppended(qtcPchFile);
-                FileUtils::copyIfDifferent(precompiled_header, qtc_precompiled_header);
-
-                rpp.setPreCompiledHeaders({qtc_precompiled_header.path()});
-            }
+    std::vector<size_t> targetIndexes(input.targetDetails.size());
+    std::iota(targetIndexes.begin(), targetIndexes.end(), 0);
 
-            RawProjectPartFlags projectFlags;
-            projectFlags.commandLineFlags = fragments;
-            if (ci.language == "C")
-                rpp.setFlagsForC(projectFlags);
-            else if (ci.language == "CXX")
-                rpp.setFlagsForCxx(projectFlags);
+    // The targets are independent of each other, so they are converted concurrently.
+    // The mapped results keep the order of the targets.
+    QFuture<TargetParts> mapResult
+        = QtConcurrent::mapped(targetIndexes,
+                               [&cancelFuture, &input, &sourceDirectory, &buildDirectory](size_t i) {
+              TargetParts parts;
+              if (cancelFuture.isCanceled())
+                  return parts;
+
+              const CachedTarget *cached = cachedTarget(input, i);
+              if (cached && cached->projectParts) {
+                  parts.rpps = *cached->projectParts;
+                  parts.cached = true;
+                  return parts;
+              }
+
+              parts.rpps = generateRawProjectParts(input.targetDetails[i],
+                                                   sourceDirectory,
+                                                   buildDirectory,
+                                                   input.sourceClassifications,
+                                                   input.sourceMimeTypes,
+                                                   &parts.pchCopies);
+              // The PCH copy needs to be refreshed on every parse:
+              parts.cacheable = parts.pchCopies.isEmpty();
+              return parts;
+          });
+    mapResult.waitForFinished();
 
-            const bool isExecutable = t.type == "EXECUTABLE";
-            rpp.setBuildTargetType(isExecutable ? BuildTargetType::Executable
-                                                : BuildTargetType::Library);
-            rpps.append(rpp);
-            ++count;
+    if (cancelFuture.isCanceled())
+        return {};
+
+    std::vector<RawProjectParts> result;
+    result.reserve(input.targetDetails.size());
+    cacheable->clear();
+    cacheable->reserve(input.targetDetails.size());
+
+    // The pool is not thread-safe, so the values are interned while merging. The PCH copies
+    // are made here as well, once per header, instead of racing on the same file:
+    QSet<FilePath> copiedHeaders;
+    QList<TargetParts> targetParts = mapResult.results();
+    for (TargetParts &parts : targetParts) {
+        if (!parts.cached) {
+            for (RawProjectPart &rpp : parts.rpps)
+                stringPool.internProjectPart(rpp);
         }
+        for (const auto &[header, copy] : std::as_const(parts.pchCopies)) {
+            const int count = copiedHeaders.count();
+            copiedHeaders.insert(copy);
+            if (count != copiedHeaders.count())
+                FileUtils::copyIfDifferent(header, copy);
+        }
+        result.push_back(std::move(parts.rpps));
+        cacheable->push_back(parts.cacheable);
     }
 
-    return rpps;
+    return result;
+}
+
+static std::shared_ptr<const FileApiTargetCache> updateTargetCache(
+    const PreprocessedData &input,
+    const QList<CMakeBuildTarget> &buildTargets,
+    const std::vector<RawProjectParts> &projectParts,
+    const std::vector<bool> &cacheable,
+    bool relativeLibs)
+{
+    QTC_ASSERT(size_t(input.targetFiles.size()) == input.targetDetails.size(), return {});
+    QTC_ASSERT(size_t(buildTargets.size()) == input.targetDetails.size(), return {});
+    QTC_ASSERT(projectParts.size() == input.targetDetails.size(), return {});
+
+    auto cache = std::make_shared<FileApiTargetCache>();
+    cache->relativeLibs = relativeLibs;
+    cache->targets.reserve(input.targetFiles.size());
+    for (size_t i = 0; i < input.targetDetails.size(); ++i) {
+        const QString &file = input.targetFiles.at(i);
+        if (input.targetCache && input.targetCache->relativeLibs == relativeLibs && cacheable[i]) {
+            const std::shared_ptr<const CachedTarget> cached = input.targetCache->targets.value(file);
+            if (cached) {
+                cache->targets.insert(file, cached);
+                continue;
+            }
+        }
+
+        auto entry = std::make_shared<CachedTarget>();
+        if (input.replyCache)
+            entry->details = input.replyCache->targetDetails.value(file);
+        if (!entry->details)
+            entry->details = std::make_shared<const TargetDetails>(input.targetDetails[i]);
+        entry->buildTarget = buildTargets.at(i);
+        if (cacheable[i])
+            entry->projectParts = projectParts[i];
+        cache->targets.insert(file, entry);
+    }
+
+    // Keep the targets of the other configurations of a multi-config build directory
+    // around, switching back to them does not need to extract them again:
+    if (input.targetCache && input.targetCache->relativeLibs == relativeLibs && input.replyCache
+        && input.replyCache->configurations.size() > 1) {
+        for (auto it = input.targetCache->targets.cbegin(); it != input.targetCache->targets.cend();
+             ++it) {
+            if (!cache->targets.contains(it.key())
+                && input.replyCache->targetDetails.contains(it.key())) {
+                cache->targets.insert(it.key(), it.value());
+            }
+        }
+    }
+    return cache;
 }
 
 static FilePath directorySourceDir(const Configuration &c,
@@ -569,7 +917,8 @@ static FilePath directoryBuildDir(const Configuration &c,
 static void addProjects(const QFuture<void> &cancelFuture,
                         const QHash<FilePath, ProjectNode *> &cmakeListsNodes,
                         const Configuration &config,
-                        const FilePath &sourceDir)
+                        const FilePath &sourceDir,
+                        TreeNodeIndex &index)
 {
     for (const FileApiDetails::Project &p : config.projects) {
         if (cancelFuture.isCanceled())
@@ -578,7 +927,7 @@ static void addProjects(const QFuture<void> &cancelFuture,
         if (p.parent == -1)
             continue; // Top-level project has already been covered
         FilePath dir = directorySourceDir(config, sourceDir, p.directories[0]);
-        createProjectNode(cmakeListsNodes, dir, p.name);
+        createProjectNode(cmakeListsNodes, dir, p.name, index);
     }
 }
 
@@ -614,7 +963,8 @@ static void addCompileGroups(ProjectNode *targetRoot,
                              const FilePath &topSourceDirectory,
                              const FilePath &sourceDirectory,
                              const FilePath &buildDirectory,
-                             const TargetDetails &td)
+                             const TargetDetails &td,
+                             const SourceClassifications &classifications)
 {
     const bool showSourceFolders = settings().showSourceSubFolders();
     const bool inSourceBuild = (sourceDirectory == buildDirectory);
@@ -630,7 +980,10 @@ static void addCompileGroups(ProjectNode *targetRoot,
     std::vector<std::vector<std::unique_ptr<FileNode>>> sourceGroupFileNodes{td.sourceGroups.size()};
 
     for (const SourceInfo &si : td.sources) {
-        const FilePath sourcePath = topSourceDirectory.resolvePath(si.path);
+        const auto classification = classifications.constFind(si.path);
+        const bool isClassified = classification != classifications.constEnd();
+        const FilePath sourcePath = isClassified ? classification->path
+                                                 : topSourceDirectory.resolvePath(si.path);
 
         // Filter out already known files:
         const int count = alreadyListed.count();
@@ -639,7 +992,9 @@ static void addCompileGroups(ProjectNode *targetRoot,
             continue;
 
         // Create FileNodes from the file
-        auto node = std::make_unique<FileNode>(sourcePath, Node::fileTypeForFileName(sourcePath));
+        auto node = std::make_unique<FileNode>(sourcePath,
+                                               isClassified ? classification->fileType
+                                                            : Node::fileTypeForFileName(sourcePath));
         node->setIsGenerated(si.isGenerated);
 
         // CMake pch / unity files are generated at configured time, but not marked as generated
@@ -713,8 +1068,10 @@ static void addTargets(const QFuture<void> &cancelFuture,
                        const QHash<FilePath, ProjectNode *> &cmakeListsNodes,
                        const Configuration &config,
                        const std::vector<TargetDetails> &targetDetails,
+                       const SourceClassifications &classifications,
                        const FilePath &sourceDir,
-                       const FilePath &buildDir)
+                       const FilePath &buildDir,
+                       TreeNodeIndex &index)
 {
     QHash<QString, const TargetDetails *> targetDetailsHash;
     for (const TargetDetails &t : targetDetails)
@@ -736,13 +1093,13 @@ static void addTargets(const QFuture<void> &cancelFuture,
 
         const FilePath dir = directorySourceDir(config, sourceDir, t.directory);
 
-        CMakeTargetNode *tNode = createTargetNode(cmakeListsNodes, dir, t.name);
+        CMakeTargetNode *tNode = createTargetNode(cmakeListsNodes, dir, t.name, index);
         QTC_ASSERT(tNode, continue);
 
         tNode->setTargetInformation(td.artifacts, td.type);
         tNode->setBuildDirectory(directoryBuildDir(config, buildDir, t.directory));
 
-        addCompileGroups(tNode, sourceDir, dir, tNode->buildDirectory(), td);
+        addCompileGroups(tNode, sourceDir, dir, tNode->buildDirectory(), td, classifications);
         addGeneratedFilesNode(tNode, buildDir, td);
     }
 }
@@ -765,7 +1122,8 @@ static std::unique_ptr<CMakeProjectNode> generateRootProjectNode(const QFuture<v
                                                                    std::move(data.cmakeListNodes));
     data.cmakeListNodes.clear(); // Remove all the nullptr in the vector...
 
-    addProjects(cancelFuture, cmakeListsNodes, data.codemodel, sourceDirectory);
+    TreeNodeIndex index;
+    addProjects(cancelFuture, cmakeListsNodes, data.codemodel, sourceDirectory, index);
     if (cancelFuture.isCanceled())
         return {};
 
@@ -773,8 +1131,10 @@ static std::unique_ptr<CMakeProjectNode> generateRootProjectNode(const QFuture<v
                cmakeListsNodes,
                data.codemodel,
                data.targetDetails,
+               data.sourceClassifications,
                sourceDirectory,
-               buildDirectory);
+               buildDirectory,
+               index);
     if (cancelFuture.isCanceled())
         return {};
 
@@ -910,6 +1270,27 @@ std::unique_ptr<CMakeProjectNode> generateRootProjectNodePlain(const QFuture<voi
     return result;
 }
 
+static std::unique_ptr<CMakeProjectNode> generateProjectTree(const QFuture<void> &cancelFuture,
+                                                             PreprocessedData &data,
+                                                             const QList<CMakeBuildTarget> &buildTargets,
+                                                             const FilePath &sourceDir,
+                                                             const FilePath &buildDir,
+                                                             bool plain)
+{
+    auto rootProjectNode = !plain ? generateRootProjectNode(cancelFuture, data, sourceDir, buildDir)
+                                  : generateRootProjectNodePlain(cancelFuture, data, sourceDir, buildDir);
+    if (cancelFuture.isCanceled())
+        return {};
+    if (ProjectTree::instance()) // Not available outside of the IDE, e.g. in the benchmark
+        ProjectTree::applyTreeManager(rootProjectNode.get(), ProjectTree::AsyncPhase); // QRC nodes
+
+    setupLocationInfoForTargets(cancelFuture, rootProjectNode.get(), buildTargets);
+    if (cancelFuture.isCanceled())
+        return {};
+
+    return rootProjectNode;
+}
+
 // --------------------------------------------------------------------
 // extractData:
 // --------------------------------------------------------------------
@@ -924,6 +1305,8 @@ FileApiQtcData extractData(const QFuture<void> &cancelFuture, FileApiData &input
     PreprocessedData data = preprocess(cancelFuture, input, sourceDir, buildDir);
     if (cancelFuture.isCanceled())
         return {};
+    data.targetCache = input.targetCache.get();
+    data.replyCache = input.replyCache.get();
 
     result.cache = std::move(data.cache); // Make sure this is available, even when nothing else is
     if (!result.errorMessage.isEmpty())
@@ -934,26 +1317,57 @@ FileApiQtcData extractData(const QFuture<void> &cancelFuture, FileApiData &input
             input.replyFile.generator.startsWith("Ninja")
          && input.replyFile.cmakeVersion >= QVersionNumber(3, 20, 5);
 
-    result.buildTargets = generateBuildTargets(cancelFuture, data, sourceDir, buildDir,
-                                               haveLibrariesRelativeToBuildDirectory);
+    {
+        ParseTimings::Phase phase(input.timings, "generateBuildTargets");
+        result.buildTargets = generateBuildTargets(cancelFuture, data, sourceDir, buildDir,
+                                                   haveLibrariesRelativeToBuildDirectory);
+        phase.setCount(result.buildTargets.size());
+    }
     if (cancelFuture.isCanceled())
         return {};
     result.cmakeFiles = std::move(data.cmakeFiles);
-    result.projectParts = generateRawProjectParts(cancelFuture, data, sourceDir, buildDir);
+    {
+        ParseTimings::Phase phase(input.timings, "classifySources");
+        data.sourceClassifications = classifySources(cancelFuture, data, sourceDir, buildDir);
+        data.sourceMimeTypes = sourceMimeTypes(data.sourceClassifications);
+        phase.setCount(data.sourceClassifications.size());
+    }
     if (cancelFuture.isCanceled())
         return {};
-
-    auto rootProjectNode = !plain ? generateRootProjectNode(cancelFuture, data, sourceDir, buildDir)
-                                  : generateRootProjectNodePlain(cancelFuture, data, sourceDir, buildDir);
+    std::vector<bool> cacheableProjectParts;
+    std::vector<RawProjectParts> targetProjectParts;
+    {
+        ParseTimings::Phase phase(input.timings, "generateRawProjectParts");
+        targetProjectParts = generateRawProjectParts(cancelFuture, data, sourceDir, buildDir,
+                                                     input.stringPool, &cacheableProjectParts);
+        for (const RawProjectParts &rpps : targetProjectParts)
+            result.projectParts.append(rpps);
+        phase.setCount(result.projectParts.size());
+    }
     if (cancelFuture.isCanceled())
         return {};
-    ProjectTree::applyTreeManager(rootProjectNode.get(), ProjectTree::AsyncPhase); // QRC nodes
-    result.rootProjectNode = std::move(rootProjectNode);
 
-    setupLocationInfoForTargets(cancelFuture, result.rootProjectNode.get(), result.buildTargets);
+    result.targetCache = updateTargetCache(data,
+                                           result.buildTargets,
+                                           targetProjectParts,
+                                           cacheableProjectParts,
+                                           haveLibrariesRelativeToBuildDirectory);
+
+    result.replyCache = input.replyCache;
+    result.cmakeFileCache = std::move(data.cmakeFileCache);
+
+    {
+        ParseTimings::Phase phase(input.timings, "Root node generation");
+        result.rootProjectNode = generateProjectTree(cancelFuture, data, result.buildTargets,
+                                                     sourceDir, buildDir, plain);
+    }
     if (cancelFuture.isCanceled())
         return {};
 
+    // Kept for the snapshot, the target details are in the target cache:
+    result.codemodel = std::make_shared<const Configuration>(std::move(data.codemodel));
+    result.targetFiles = std::move(data.targetFiles);
+
     result.ctestPath = input.replyFile.ctestExecutable;
     result.isMultiConfig = input.replyFile.isMultiConfig;
     if (input.replyFile.isMultiConfig && input.replyFile.generator != "Ninja Multi-Config")
@@ -962,4 +1376,102 @@ FileApiQtcData extractData(const QFuture<void> &cancelFuture, FileApiData &input
     return result;
 }
 
+void restoreProjectTree(const QFuture<void> &cancelFuture, FileApiData &input,
+                        FileApiQtcData &result, const FilePath &sourceDir,
+                        const FilePath &buildDir, bool plain)
+{
+    // The cmake files were parsed already, only their nodes are needed. Files that were
+    // edited after the snapshot was written are parsed again, like a regular parse would do.
+    auto cmakeFileCache = std::make_shared<CMakeFileCache>();
+    QList<CMakeFileInfo> cmakeFiles;
+    cmakeFiles.reserve(result.cmakeFiles.size());
+    for (CMakeFileInfo info : std::as_const(result.cmakeFiles)) {
+        if (cancelFuture.isCanceled())
+            return;
+        if (info.size < 0) { // Not parsed
+            cmakeFiles.append(info);
+            continue;
+        }
+        std::optional<CMakeFileCache::Entry> cacheEntry
+            = CMakeFileCache::Entry{info.lastModified, info.size, info.cmakeListFile};
+        if (!info.isGenerated) {
+            const FilePathInfo fileInfo = info.path.filePathInfo();
+            if (fileInfo.lastModified != info.lastModified || fileInfo.fileSize != info.size) {
+                qCDebug(cmakeLogger) << "Changed since the snapshot:" << info.path;
+                info.cmakeListFile = {};
+                info.lastModified = fileInfo.lastModified;
+                info.size = fileInfo.fileSize;
+                cacheEntry = parseCMakeFile(info.path, fileInfo, info.cmakeListFile);
+            }
+        }
+        if (cacheEntry)
+            cmakeFileCache->files.insert(info.path, *cacheEntry);
+        cmakeFiles.append(info);
+    }
+    Utils::sort(cmakeFiles);
+    result.cmakeFiles = Utils::toSet(cmakeFiles);
+    result.cmakeFileCache = std::move(cmakeFileCache);
+
+    // Like a regular parse, refresh the copies of the CMake PCH headers. The project parts
+    // refer to the copies, which are named after the CMake header with a "qtc_" prefix:
+    QSet<FilePath> copiedHeaders;
+    for (const RawProjectPart &rpp : std::as_const(result.projectParts)) {
+        for (const QString &header : rpp.precompiledHeaders) {
+            const FilePath copy = FilePath::fromString(header);
+            const int count = copiedHeaders.count();
+            copiedHeaders.insert(copy);
+            if (count != copiedHeaders.count() && copy.fileName().startsWith("qtc_"))
+                FileUtils::copyIfDifferent(copy.parentDir().pathAppended(copy.fileName().mid(4)),
+                                           copy);
+        }
+    }
+
+    CMakeFileResult cmakeFileResult = cmakeFileNodes(cancelFuture, cmakeFiles, sourceDir, buildDir);
+    if (cancelFuture.isCanceled())
+        return;
+
+    PreprocessedData data;
+    data.codemodel = std::move(input.codemodel);
+    data.targetDetails = std::move(input.targetDetails);
+    data.cmakeNodesSource = std::move(cmakeFileResult.cmakeNodesSource);
+    data.cmakeNodesBuild = std::move(cmakeFileResult.cmakeNodesBuild);
+    data.cmakeNodesOther = std::move(cmakeFileResult.cmakeNodesOther);
+    data.cmakeListNodes = std::move(cmakeFileResult.cmakeListNodes);
+
+    ParseTimings::Phase phase(input.timings, "Root node generation");
+    result.rootProjectNode = generateProjectTree(cancelFuture, data, result.buildTargets,
+                                                 sourceDir, buildDir, plain);
+}
+
+std::unique_ptr<CMakeProjectNode> generatePreviewTree(const QFuture<void> &cancelFuture,
+                                                      const FileApiData &input,
+                                                      const FilePath &sourceDir,
+                                                      const FilePath &buildDir,
+                                                      bool plain)
+{
+    // The cmake files are only listed, they are parsed with the complete data:
+    std::set<CMakeFileInfo> cmakeFileSet;
+    for (const CMakeFileInfo &info : input.cmakeFiles) {
+        CMakeFileInfo absolute(info);
+        absolute.path = sourceDir.resolvePath(info.path);
+        cmakeFileSet.insert(absolute);
+    }
+    CMakeFileResult cmakeFileResult
+        = cmakeFileNodes(cancelFuture, QList<CMakeFileInfo>(cmakeFileSet.begin(), cmakeFileSet.end()),
+                         sourceDir, buildDir);
+    if (cancelFuture.isCanceled())
+        return {};
+
+    // Without target details, the targets get no sources:
+    PreprocessedData data;
+    data.codemodel = input.codemodel;
+    data.cmakeNodesSource = std::move(cmakeFileResult.cmakeNodesSource);
+    data.cmakeNodesBuild = std::move(cmakeFileResult.cmakeNodesBuild);
+    data.cmakeNodesOther = std::move(cmakeFileResult.cmakeNodesOther);
+    data.cmakeListNodes = std::move(cmakeFileResult.cmakeListNodes);
+
+    ParseTimings::Phase phase(input.timings, "Preview node generation");
+    return generateProjectTree(cancelFuture, data, {}, sourceDir, buildDir, plain);
+}
+
 } // CMakeProjectManager::Internal
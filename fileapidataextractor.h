@@ -11,9 +11,12 @@
 
 #include <utils/filepath.h>
 
+#include <QDateTime>
+#include <QHash>
 #include <QList>
 #include <QSet>
 #include <QString>
+#include <QStringList>
 
 #include <memory>
 #include <optional>
@@ -21,6 +24,12 @@
 namespace CMakeProjectManager::Internal {
 
 class FileApiData;
+class FileApiReplyCache;
+class FileApiTargetCache;
+
+namespace FileApiDetails {
+class Configuration;
+}
 
 class CMakeFileInfo
 {
@@ -36,6 +45,25 @@ public:
     bool isExternal = false;
     bool isGenerated = false;
     cmListFile cmakeListFile;
+    // Of the parsed file, invalid if not known
+    QDateTime lastModified;
+    qint64 size = -1;
+};
+
+// The parsed CMake files of the last parse, reused for files whose size and modification
+// time did not change since then.
+class CMakeFileCache
+{
+public:
+    class Entry
+    {
+    public:
+        QDateTime lastModified;
+        qint64 size = -1;
+        cmListFile cmakeListFile;
+    };
+
+    QHash<Utils::FilePath, Entry> files; // Keyed by absolute path
 };
 
 class FileApiQtcData
@@ -50,10 +78,30 @@ public:
     QString ctestPath;
     bool isMultiConfig = false;
     bool usesAllCapsTargets = false;
+    bool isPreview = false; // Only rootProjectNode is set, see generatePreviewTree
+    bool isRestored = false; // Read from a FileApiSnapshot
+    std::shared_ptr<const FileApiDetails::Configuration> codemodel;
+    QStringList targetFiles; // Reply file names of the targets of codemodel, see targetCache
+    std::shared_ptr<const FileApiTargetCache> targetCache;
+    std::shared_ptr<const FileApiReplyCache> replyCache;
+    std::shared_ptr<const CMakeFileCache> cmakeFileCache;
 };
 
 FileApiQtcData extractData(const QFuture<void> &cancelFuture, FileApiData &input,
                            const Utils::FilePath &sourceDir, const Utils::FilePath &buildDir,
                            bool plain = false);
 
+// Recreates the project tree of a result restored from a FileApiSnapshot
+void restoreProjectTree(const QFuture<void> &cancelFuture, FileApiData &input,
+                        FileApiQtcData &result, const Utils::FilePath &sourceDir,
+                        const Utils::FilePath &buildDir, bool plain = false);
+
+// Creates the project tree from the result of FileApiParser::parseCodemodel, with the
+// targets, but without their sources
+std::unique_ptr<CMakeProjectNode> generatePreviewTree(const QFuture<void> &cancelFuture,
+                                                      const FileApiData &input,
+                                                      const Utils::FilePath &sourceDir,
+                                                      const Utils::FilePath &buildDir,
+                                                      bool plain = false);
+
 } // CMakeProjectManager::Internal
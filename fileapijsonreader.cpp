@@ -0,0 +1,419 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "fileapijsonreader.h"
+
+#include <cmath>
+#include <limits>
+
+namespace CMakeProjectManager::Internal {
+
+// --------------------------------------------------------------------
+// Helper:
+// --------------------------------------------------------------------
+
+static bool readHex4(const char *&pos, const char *end, char32_t &value)
+{
+    if (end - pos < 4)
+        return false;
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+        const char c = *pos++;
+        value <<= 4;
+        if (c >= '0' && c <= '9')
+            value |= char32_t(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            value |= char32_t(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+            value |= char32_t(c - 'A' + 10);
+        else
+            return false;
+    }
+    return true;
+}
+
+static void appendUtf8(QByteArray &out, char32_t cp)
+{
+    if (cp < 0x80) {
+        out.append(char(cp));
+    } else if (cp < 0x800) {
+        out.append(char(0xC0 | (cp >> 6)));
+        out.append(char(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.append(char(0xE0 | (cp >> 12)));
+        out.append(char(0x80 | ((cp >> 6) & 0x3F)));
+        out.append(char(0x80 | (cp & 0x3F)));
+    } else {
+        out.append(char(0xF0 | (cp >> 18)));
+        out.append(char(0x80 | ((cp >> 12) & 0x3F)));
+        out.append(char(0x80 | ((cp >> 6) & 0x3F)));
+        out.append(char(0x80 | (cp & 0x3F)));
+    }
+}
+
+static QByteArray unescape(QByteArrayView raw)
+{
+    QByteArray result;
+    result.reserve(raw.size());
+
+    const char *pos = raw.data();
+    const char *end = pos + raw.size();
+    while (pos < end) {
+        const char c = *pos++;
+        if (c != '\\') {
+            result.append(c);
+            continue;
+        }
+        if (pos == end)
+            break;
+
+        const char escaped = *pos++;
+        switch (escaped) {
+        case 'b': result.append('\b'); break;
+        case 'f': result.append('\f'); break;
+        case 'n': result.append('\n'); break;
+        case 'r': result.append('\r'); break;
+        case 't': result.append('\t'); break;
+        case 'u': {
+            char32_t cp = 0;
+            if (!readHex4(pos, end, cp))
+                return result;
+            // Combine surrogate pairs:
+            if (cp >= 0xD800 && cp < 0xDC00 && end - pos >= 6 && pos[0] == '\\' && pos[1] == 'u') {
+                const char *low = pos + 2;
+                char32_t lowCp = 0;
+                if (readHex4(low, end, lowCp) && lowCp >= 0xDC00 && lowCp < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lowCp - 0xDC00);
+                    pos = low;
+                }
+            }
+            appendUtf8(result, cp);
+            break;
+        }
+        default: // '"', '\\' and '/'
+            result.append(escaped);
+            break;
+        }
+    }
+    return result;
+}
+
+// --------------------------------------------------------------------
+// JsonPullReader:
+// --------------------------------------------------------------------
+
+JsonPullReader::JsonPullReader(QByteArrayView data)
+    : m_pos(data.data())
+    , m_end(data.data() + data.size())
+{}
+
+bool JsonPullReader::atEnd()
+{
+    skipWhitespace();
+    return m_pos == m_end;
+}
+
+bool JsonPullReader::finish()
+{
+    if (!atEnd())
+        setError();
+    return !m_hasError;
+}
+
+JsonPullReader::Type JsonPullReader::peek()
+{
+    skipWhitespace();
+    if (m_pos == m_end)
+        return Type::Invalid;
+
+    switch (*m_pos) {
+    case '{': return Type::Object;
+    case '[': return Type::Array;
+    case '"': return Type::String;
+    case 't':
+    case 'f': return Type::Bool;
+    case 'n': return Type::Null;
+    case '-': return Type::Number;
+    default:
+        return (*m_pos >= '0' && *m_pos <= '9') ? Type::Number : Type::Invalid;
+    }
+}
+
+bool JsonPullReader::enterObject()
+{
+    if (peek() != Type::Object) {
+        skipValue();
+        return false;
+    }
+    ++m_pos;
+    m_isFirst.push_back(true);
+    return true;
+}
+
+bool JsonPullReader::nextKey(QByteArrayView &key)
+{
+    if (!nextInContainer('}'))
+        return false;
+
+    if (peek() != Type::String) {
+        setError();
+        return false;
+    }
+
+    QByteArrayView raw;
+    bool hasEscapes = false;
+    if (!scanString(raw, hasEscapes))
+        return false;
+    if (hasEscapes) {
+        m_keyBuffer = unescape(raw);
+        key = m_keyBuffer;
+    } else {
+        key = raw;
+    }
+
+    skipWhitespace();
+    if (m_pos == m_end || *m_pos != ':') {
+        setError();
+        return false;
+    }
+    ++m_pos;
+    return true;
+}
+
+bool JsonPullReader::enterArray()
+{
+    if (peek() != Type::Array) {
+        skipValue();
+        return false;
+    }
+    ++m_pos;
+    m_isFirst.push_back(true);
+    return true;
+}
+
+bool JsonPullReader::nextElement()
+{
+    return nextInContainer(']');
+}
+
+QString JsonPullReader::readString()
+{
+    if (peek() != Type::String) {
+        skipValue();
+        return {};
+    }
+
+    QByteArrayView raw;
+    bool hasEscapes = false;
+    if (!scanString(raw, hasEscapes))
+        return {};
+    if (hasEscapes)
+        return QString::fromUtf8(unescape(raw));
+    return QString::fromUtf8(raw.data(), raw.size());
+}
+
+QByteArray JsonPullReader::readUtf8()
+{
+    if (peek() != Type::String) {
+        skipValue();
+        return {};
+    }
+
+    QByteArrayView raw;
+    bool hasEscapes = false;
+    if (!scanString(raw, hasEscapes))
+        return {};
+    if (hasEscapes)
+        return unescape(raw);
+    return raw.toByteArray();
+}
+
+int JsonPullReader::readInt(int defaultValue)
+{
+    if (peek() != Type::Number) {
+        skipValue();
+        return defaultValue;
+    }
+
+    const QByteArrayView number = scanNumber();
+    if (number.isEmpty())
+        return defaultValue;
+
+    // Fast path for the plain integers used for all indexes:
+    const char *pos = number.data();
+    const char *end = pos + number.size();
+    const bool negative = *pos == '-';
+    if (negative)
+        ++pos;
+    if (pos < end && end - pos <= 9) {
+        int value = 0;
+        for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos)
+            value = value * 10 + (*pos - '0');
+        if (pos == end)
+            return negative ? -value : value;
+    }
+
+    // Same semantics as QJsonValue::toInt(): Only integral values in range are accepted.
+    bool ok = false;
+    const double value = number.toByteArray().toDouble(&ok);
+    if (!ok || std::trunc(value) != value || value < std::numeric_limits<int>::min()
+        || value > std::numeric_limits<int>::max()) {
+        return defaultValue;
+    }
+    return static_cast<int>(value);
+}
+
+bool JsonPullReader::readBool(bool defaultValue)
+{
+    if (peek() != Type::Bool) {
+        skipValue();
+        return defaultValue;
+    }
+    if (*m_pos == 't')
+        return scanLiteral("true") ? true : defaultValue;
+    return scanLiteral("false") ? false : defaultValue;
+}
+
+void JsonPullReader::skipValue()
+{
+    switch (peek()) {
+    case Type::String: {
+        QByteArrayView raw;
+        bool hasEscapes = false;
+        scanString(raw, hasEscapes);
+        return;
+    }
+    case Type::Number:
+        scanNumber();
+        return;
+    case Type::Bool:
+        scanLiteral(*m_pos == 't' ? "true" : "false");
+        return;
+    case Type::Null:
+        scanLiteral("null");
+        return;
+    case Type::Object:
+    case Type::Array:
+        break;
+    case Type::Invalid:
+        setError();
+        return;
+    }
+
+    // Skip a whole object or array without looking at its values:
+    int depth = 0;
+    while (m_pos < m_end) {
+        const char c = *m_pos;
+        if (c == '"') {
+            QByteArrayView raw;
+            bool hasEscapes = false;
+            if (!scanString(raw, hasEscapes))
+                return;
+            continue;
+        }
+        ++m_pos;
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (--depth == 0)
+                return;
+        }
+    }
+    setError();
+}
+
+void JsonPullReader::skipWhitespace()
+{
+    while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t'))
+        ++m_pos;
+}
+
+bool JsonPullReader::scanString(QByteArrayView &raw, bool &hasEscapes)
+{
+    // m_pos points to the opening quote
+    ++m_pos;
+    const char *start = m_pos;
+    hasEscapes = false;
+    while (m_pos < m_end) {
+        const char c = *m_pos;
+        if (c == '"') {
+            raw = QByteArrayView(start, m_pos - start);
+            ++m_pos;
+            return true;
+        }
+        if (c == '\\') {
+            if (m_end - m_pos < 2)
+                break;
+            hasEscapes = true;
+            m_pos += 2;
+            continue;
+        }
+        ++m_pos;
+    }
+    setError();
+    return false;
+}
+
+QByteArrayView JsonPullReader::scanNumber()
+{
+    const char *start = m_pos;
+    while (m_pos < m_end) {
+        const char c = *m_pos;
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')
+            ++m_pos;
+        else
+            break;
+    }
+    if (m_pos == start)
+        setError();
+    return QByteArrayView(start, m_pos - start);
+}
+
+bool JsonPullReader::scanLiteral(QByteArrayView literal)
+{
+    if (m_end - m_pos < literal.size()
+        || QByteArrayView(m_pos, literal.size()) != literal) {
+        setError();
+        return false;
+    }
+    m_pos += literal.size();
+    return true;
+}
+
+bool JsonPullReader::nextInContainer(char close)
+{
+    skipWhitespace();
+    if (m_hasError || m_isFirst.empty())
+        return false;
+
+    if (m_pos < m_end && *m_pos == close) {
+        ++m_pos;
+        m_isFirst.pop_back();
+        return false;
+    }
+
+    if (!m_isFirst.back()) {
+        if (m_pos == m_end || *m_pos != ',') {
+            setError();
+            return false;
+        }
+        ++m_pos;
+        skipWhitespace();
+    }
+    m_isFirst.back() = false;
+
+    if (m_pos == m_end) {
+        setError();
+        return false;
+    }
+    return true;
+}
+
+void JsonPullReader::setError()
+{
+    m_hasError = true;
+    m_pos = m_end;
+    m_isFirst.clear();
+}
+
+} // CMakeProjectManager::Internal
@@ -0,0 +1,88 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+
+#include <vector>
+
+namespace CMakeProjectManager::Internal {
+
+// Minimal pull reader for the JSON files written by the CMake file-api.
+//
+// The reader works directly on the file contents and never builds a document tree.
+// Every value has to be consumed by exactly one of the read*(), enter*() or skipValue()
+// calls. Reading a value of the wrong type skips it and returns the default, which
+// mirrors the behavior of the QJsonValue::to*() accessors.
+class JsonPullReader
+{
+public:
+    enum class Type { Invalid, Null, Bool, Number, String, Array, Object };
+
+    explicit JsonPullReader(QByteArrayView data);
+
+    bool hasError() const { return m_hasError; }
+    bool atEnd();
+    bool finish(); // Marks trailing data as error, returns false if the input was invalid
+
+    Type peek();
+
+    bool enterObject();
+    bool nextKey(QByteArrayView &key);
+    bool enterArray();
+    bool nextElement();
+
+    QString readString();
+    QByteArray readUtf8();
+    int readInt(int defaultValue = 0);
+    bool readBool(bool defaultValue = false);
+    void skipValue();
+
+    // Calls function(key) for every member of an object. Returns the number of members.
+    template<typename Function>
+    int readObject(const Function &function)
+    {
+        int count = 0;
+        if (!enterObject())
+            return count;
+        QByteArrayView key;
+        while (nextKey(key)) {
+            function(key);
+            ++count;
+        }
+        return count;
+    }
+
+    // Calls function() for every element of an array. Returns the number of elements.
+    template<typename Function>
+    int readArray(const Function &function)
+    {
+        int count = 0;
+        if (!enterArray())
+            return count;
+        while (nextElement()) {
+            function();
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    void skipWhitespace();
+    bool scanString(QByteArrayView &raw, bool &hasEscapes);
+    QByteArrayView scanNumber();
+    bool scanLiteral(QByteArrayView literal);
+    bool nextInContainer(char close);
+    void setError();
+
+    const char *m_pos = nullptr;
+    const char *m_end = nullptr;
+    QByteArray m_keyBuffer;
+    std::vector<bool> m_isFirst;
+    bool m_hasError = false;
+};
+
+} // CMakeProjectManager::Internal
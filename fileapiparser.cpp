@@ -3,21 +3,26 @@
 
 #include "fileapiparser.h"
 
+#include "cmakeparsetimings.h"
 #include "cmakeprocess.h"
 #include "cmakeprojectmanagertr.h"
+#include "fileapijsonreader.h"
 
 #include <coreplugin/messagemanager.h>
 #include <projectexplorer/rawprojectpart.h>
 
 #include <utils/algorithm.h>
+#include <utils/environment.h>
 #include <utils/qtcassert.h>
 
+#include <QFile>
 #include <QGuiApplication>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLoggingCategory>
 #include <QPromise>
+#include <QtConcurrent>
 
 using namespace Utils;
 
@@ -57,14 +62,56 @@ static std::pair<int, int> cmakeVersion(const QJsonObject &obj)
     return {major, minor};
 }
 
-static bool checkJsonObject(const QJsonObject &obj, const QString &kind, int major, int minor = -1)
+static bool checkKindAndVersion(const QString &objKind,
+                                std::pair<int, int> version,
+                                const QString &kind,
+                                int major,
+                                int minor = -1)
 {
-    auto version = cmakeVersion(obj);
     if (major == -1)
         version.first = major;
     if (minor == -1)
         version.second = minor;
-    return obj.value("kind").toString() == kind && version == std::make_pair(major, minor);
+    return objKind == kind && version == std::make_pair(major, minor);
+}
+
+static bool checkJsonObject(const QJsonObject &obj, const QString &kind, int major, int minor = -1)
+{
+    return checkKindAndVersion(obj.value("kind").toString(), cmakeVersion(obj), kind, major, minor);
+}
+
+static std::pair<int, int> readVersion(JsonPullReader &r)
+{
+    int major = -1;
+    int minor = -1;
+    r.readObject([&](QByteArrayView key) {
+        if (key == "major")
+            major = r.readInt(-1);
+        else if (key == "minor")
+            minor = r.readInt(-1);
+        else
+            r.skipValue();
+    });
+    return {major, minor};
+}
+
+static QString readPathObject(JsonPullReader &r)
+{
+    QString path;
+    r.readObject([&](QByteArrayView key) {
+        if (key == "path")
+            path = r.readString();
+        else
+            r.skipValue();
+    });
+    return path;
+}
+
+static std::vector<int> readIndexList(JsonPullReader &r)
+{
+    std::vector<int> result;
+    r.readArray([&] { result.push_back(r.readInt(-1)); });
+    return result;
 }
 
 static std::pair<QString, QString> nameValue(const QJsonObject &obj)
@@ -72,17 +119,109 @@ static std::pair<QString, QString> nameValue(const QJsonObject &obj)
     return {obj.value("name").toString(), obj.value("value").toString()};
 }
 
+// The contents of a reply file. Local files are memory mapped and read in place, files on
+// devices are copied into memory by FilePath::fileContents().
+class ReplyFileData
+{
+public:
+    explicit ReplyFileData(const FilePath &filePath)
+    {
+        if (!filePath.needsDevice()) {
+            m_file.setFileName(filePath.toFSPathString());
+            if (m_file.open(QIODevice::ReadOnly)) {
+                const qint64 size = m_file.size();
+                if (size == 0)
+                    return;
+                if (const uchar *mapped = m_file.map(0, size)) {
+                    m_data = QByteArrayView(reinterpret_cast<const char *>(mapped), size);
+                    return;
+                }
+                m_file.close();
+            }
+        }
+        if (expected_str<QByteArray> contents = filePath.fileContents())
+            m_contents = std::move(*contents);
+        m_data = m_contents;
+    }
+
+    // Valid as long as this object lives
+    QByteArrayView data() const { return m_data; }
+    QByteArray bytes() const { return QByteArray::fromRawData(m_data.data(), m_data.size()); }
+
+private:
+    QFile m_file; // Unmaps on destruction
+    QByteArray m_contents;
+    QByteArrayView m_data;
+};
+
 static QJsonDocument readJsonFile(const FilePath &filePath)
 {
     qCDebug(cmakeFileApi) << "readJsonFile:" << filePath;
     QTC_ASSERT(!filePath.isEmpty(), return {});
 
-    const expected_str<QByteArray> contents = filePath.fileContents();
-    if (!contents)
-        return {};
-    const QJsonDocument doc = QJsonDocument::fromJson(*contents);
+    const ReplyFileData contents(filePath);
+    return QJsonDocument::fromJson(contents.bytes());
+}
+
+enum class JsonReaderMode { Document, Stream, Compare };
+
+// QTC_CMAKE_FILEAPI_READER=dom|stream|compare selects how the reply files are read.
+// "compare" uses the streaming reader and warns about differences to the QJsonDocument one.
+static JsonReaderMode jsonReaderMode()
+{
+    static const JsonReaderMode mode = [] {
+        const QString value = qtcEnvironmentVariable("QTC_CMAKE_FILEAPI_READER").toLower();
+        if (value == "dom")
+            return JsonReaderMode::Document;
+        if (value == "compare")
+            return JsonReaderMode::Compare;
+        return JsonReaderMode::Stream;
+    }();
+    return mode;
+}
+
+template<typename Result>
+static Result readReplyObject(const FilePath &filePath,
+                              QString &errorMessage,
+                              Result (*fromDocument)(const QJsonObject &, const FilePath &, QString &),
+                              Result (*fromStream)(JsonPullReader &, const FilePath &, QString &),
+                              bool (*isSame)(const Result &, const Result &))
+{
+    qCDebug(cmakeFileApi) << "readReplyObject:" << filePath;
+
+    QTC_CHECK(!filePath.isEmpty());
+    const ReplyFileData contents(filePath);
+
+    const JsonReaderMode mode = jsonReaderMode();
+    if (mode == JsonReaderMode::Document) {
+        return fromDocument(QJsonDocument::fromJson(contents.bytes()).object(), filePath,
+                            errorMessage);
+    }
 
-    return doc;
+    QString streamErrorMessage;
+    JsonPullReader reader(contents.data());
+    Result result = fromStream(reader, filePath, streamErrorMessage);
+
+    if (mode == JsonReaderMode::Compare) {
+        QString documentErrorMessage;
+        const Result documentResult = fromDocument(QJsonDocument::fromJson(contents.bytes()).object(),
+                                                   filePath,
+                                                   documentErrorMessage);
+        if (streamErrorMessage != documentErrorMessage || !isSame(result, documentResult)) {
+            qCWarning(cmakeFileApi) << "Streaming and document readers differ for" << filePath
+                                    << streamErrorMessage << documentErrorMessage;
+        }
+    }
+
+    if (!streamErrorMessage.isEmpty())
+        errorMessage = streamErrorMessage;
+    return result;
+}
+
+template<typename List, typename Equal>
+static bool isSameList(const List &a, const List &b, const Equal &equal)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), equal);
 }
 
 std::vector<int> indexList(const QJsonValue &v)
@@ -165,13 +304,12 @@ static ReplyFileContents readReplyFile(const FilePath &filePath, QString &errorM
 
 // Cache file:
 
-static CMakeConfig readCacheFile(const FilePath &cacheFile, QString &errorMessage)
+static CMakeConfig parseCacheDocument(const QJsonObject &root,
+                                      const FilePath &,
+                                      QString &errorMessage)
 {
     CMakeConfig result;
 
-    const QJsonDocument doc = readJsonFile(cacheFile);
-    const QJsonObject root = doc.object();
-
     if (!checkJsonObject(root, "cache", 2)) {
         errorMessage = Tr::tr("Invalid cache file generated by CMake.");
         return {};
@@ -208,15 +346,88 @@ static CMakeConfig readCacheFile(const FilePath &cacheFile, QString &errorMessag
     return result;
 }
 
+static CMakeConfig parseCacheStream(JsonPullReader &r, const FilePath &, QString &errorMessage)
+{
+    CMakeConfig result;
+    QString kind;
+    std::pair<int, int> version{-1, -1};
+
+    r.readObject([&](QByteArrayView key) {
+        if (key == "kind") {
+            kind = r.readString();
+        } else if (key == "version") {
+            version = readVersion(r);
+        } else if (key == "entries") {
+            r.readArray([&] {
+                CMakeConfigItem item;
+                r.readObject([&](QByteArrayView key) {
+                    if (key == "name") {
+                        item.key = r.readUtf8();
+                    } else if (key == "value") {
+                        item.value = r.readUtf8();
+                    } else if (key == "type") {
+                        item.type = CMakeConfigItem::typeStringToType(r.readUtf8());
+                    } else if (key == "properties") {
+                        r.readArray([&] {
+                            QString name;
+                            QString value;
+                            r.readObject([&](QByteArrayView key) {
+                                if (key == "name")
+                                    name = r.readString();
+                                else if (key == "value")
+                                    value = r.readString();
+                                else
+                                    r.skipValue();
+                            });
+                            if (name == "ADVANCED") {
+                                const auto boolValue = CMakeConfigItem::toBool(value);
+                                item.isAdvanced = boolValue.has_value() && boolValue.value();
+                            } else if (name == "HELPSTRING") {
+                                item.documentation = value.toUtf8();
+                            } else if (name == "STRINGS") {
+                                item.values = value.split(';');
+                            }
+                        });
+                    } else {
+                        r.skipValue();
+                    }
+                });
+                result.append(item);
+            });
+        } else {
+            r.skipValue();
+        }
+    });
+
+    if (!r.finish() || !checkKindAndVersion(kind, version, "cache", 2)) {
+        errorMessage = Tr::tr("Invalid cache file generated by CMake.");
+        return {};
+    }
+    return result;
+}
+
+static bool isSameCache(const CMakeConfig &a, const CMakeConfig &b)
+{
+    return isSameList(a, b, [](const CMakeConfigItem &x, const CMakeConfigItem &y) {
+        return x == y && x.isAdvanced == y.isAdvanced && x.documentation == y.documentation
+               && x.values == y.values;
+    });
+}
+
+static CMakeConfig readCacheFile(const FilePath &cacheFile, QString &errorMessage)
+{
+    return readReplyObject(cacheFile, errorMessage, &parseCacheDocument, &parseCacheStream,
+                           &isSameCache);
+}
+
 // CMake Files:
 
-static std::vector<CMakeFileInfo> readCMakeFilesFile(const FilePath &cmakeFilesFile, QString &errorMessage)
+static std::vector<CMakeFileInfo> parseCMakeFilesDocument(const QJsonObject &root,
+                                                          const FilePath &cmakeFilesFile,
+                                                          QString &errorMessage)
 {
     std::vector<CMakeFileInfo> result;
 
-    const QJsonDocument doc = readJsonFile(cmakeFilesFile);
-    const QJsonObject root = doc.object();
-
     if (!checkJsonObject(root, "cmakeFiles", 1)) {
         errorMessage = Tr::tr( "Invalid cmakeFiles file generated by CMake.");
         return {};
@@ -242,6 +453,70 @@ static std::vector<CMakeFileInfo> readCMakeFilesFile(const FilePath &cmakeFilesF
     return result;
 }
 
+static std::vector<CMakeFileInfo> parseCMakeFilesStream(JsonPullReader &r,
+                                                        const FilePath &cmakeFilesFile,
+                                                        QString &errorMessage)
+{
+    std::vector<CMakeFileInfo> result;
+    QString kind;
+    std::pair<int, int> version{-1, -1};
+
+    r.readObject([&](QByteArrayView key) {
+        if (key == "kind") {
+            kind = r.readString();
+        } else if (key == "version") {
+            version = readVersion(r);
+        } else if (key == "inputs") {
+            r.readArray([&] {
+                CMakeFileInfo info;
+                QString path;
+                r.readObject([&](QByteArrayView key) {
+                    if (key == "path")
+                        path = r.readString();
+                    else if (key == "isCMake")
+                        info.isCMake = r.readBool();
+                    else if (key == "isGenerated")
+                        info.isGenerated = r.readBool();
+                    else if (key == "isExternal")
+                        info.isExternal = r.readBool();
+                    else
+                        r.skipValue();
+                });
+                info.path = cmakeFilesFile.withNewPath(path);
+                info.isCMakeListsDotTxt = (info.path.fileName().compare(
+                                               "CMakeLists.txt",
+                                               HostOsInfo::fileNameCaseSensitivity())
+                                           == 0);
+                result.emplace_back(std::move(info));
+            });
+        } else {
+            r.skipValue();
+        }
+    });
+
+    if (!r.finish() || !checkKindAndVersion(kind, version, "cmakeFiles", 1)) {
+        errorMessage = Tr::tr( "Invalid cmakeFiles file generated by CMake.");
+        return {};
+    }
+    return result;
+}
+
+static bool isSameCMakeFiles(const std::vector<CMakeFileInfo> &a,
+                             const std::vector<CMakeFileInfo> &b)
+{
+    return isSameList(a, b, [](const CMakeFileInfo &x, const CMakeFileInfo &y) {
+        return x.path == y.path && x.isCMake == y.isCMake
+               && x.isCMakeListsDotTxt == y.isCMakeListsDotTxt && x.isExternal == y.isExternal
+               && x.isGenerated == y.isGenerated;
+    });
+}
+
+static std::vector<CMakeFileInfo> readCMakeFilesFile(const FilePath &cmakeFilesFile, QString &errorMessage)
+{
+    return readReplyObject(cmakeFilesFile, errorMessage, &parseCMakeFilesDocument,
+                           &parseCMakeFilesStream, &isSameCMakeFiles);
+}
+
 // Codemodel file:
 
 std::vector<Directory> extractDirectories(const QJsonArray &directories, QString &errorMessage)
@@ -461,12 +736,10 @@ static std::vector<Configuration> extractConfigurations(const QJsonArray &config
     return result;
 }
 
-static std::vector<Configuration> readCodemodelFile(const FilePath &codemodelFile,
-                                                    QString &errorMessage)
+static std::vector<Configuration> parseCodemodelDocument(const QJsonObject &root,
+                                                        const FilePath &,
+                                                        QString &errorMessage)
 {
-    const QJsonDocument doc = readJsonFile(codemodelFile);
-    const QJsonObject root = doc.object();
-
     if (!checkJsonObject(root, "codemodel", 2)) {
         errorMessage = Tr::tr("Invalid codemodel file generated by CMake.");
         return {};
@@ -475,6 +748,246 @@ static std::vector<Configuration> readCodemodelFile(const FilePath &codemodelFil
     return extractConfigurations(root.value("configurations").toArray(), errorMessage);
 }
 
+static std::vector<Directory> readDirectories(JsonPullReader &r, QString &errorMessage)
+{
+    std::vector<Directory> result;
+    const int count = r.readArray([&] {
+        Directory dir;
+        const int members = r.readObject([&](QByteArrayView key) {
+            if (key == "source")
+                dir.sourcePath = r.readString();
+            else if (key == "build")
+                dir.buildPath = r.readString();
+            else if (key == "parentIndex")
+                dir.parent = r.readInt(-1);
+            else if (key == "projectIndex")
+                dir.project = r.readInt(-1);
+            else if (key == "childIndexes")
+                dir.children = readIndexList(r);
+            else if (key == "targetIndexes")
+                dir.targets = readIndexList(r);
+            else if (key == "hasInstallRule")
+                dir.hasInstallRule = r.readBool();
+            else
+                r.skipValue();
+        });
+        if (members == 0) {
+            errorMessage = Tr::tr(
+                "Invalid codemodel file generated by CMake: Empty directory object.");
+            return;
+        }
+        result.emplace_back(std::move(dir));
+    });
+    if (count == 0) {
+        errorMessage = Tr::tr(
+            "Invalid codemodel file generated by CMake: No directories.");
+        return {};
+    }
+    return result;
+}
+
+static std::vector<Project> readProjects(JsonPullReader &r, QString &errorMessage)
+{
+    std::vector<Project> result;
+    const int count = r.readArray([&] {
+        Project project;
+        const int members = r.readObject([&](QByteArrayView key) {
+            if (key == "name")
+                project.name = r.readString();
+            else if (key == "parentIndex")
+                project.parent = r.readInt(-1);
+            else if (key == "childIndexes")
+                project.children = readIndexList(r);
+            else if (key == "directoryIndexes")
+                project.directories = readIndexList(r);
+            else if (key == "targetIndexes")
+                project.targets = readIndexList(r);
+            else
+                r.skipValue();
+        });
+        if (members == 0) {
+            qCDebug(cmakeFileApi) << "Empty project skipped!";
+            errorMessage = Tr::tr(
+                "Invalid codemodel file generated by CMake: Empty project object.");
+            return;
+        }
+        if (project.directories.empty()) {
+            qCDebug(cmakeFileApi) << "Invalid project skipped!";
+            errorMessage = Tr::tr(
+                "Invalid codemodel file generated by CMake: Broken project data.");
+            return;
+        }
+
+        qCDebug(cmakeFileApi) << "Project read:" << project.name << project.directories;
+        result.emplace_back(std::move(project));
+    });
+    if (count == 0) {
+        errorMessage = Tr::tr(
+            "Invalid codemodel file generated by CMake: No projects.");
+        return {};
+    }
+    return result;
+}
+
+static std::vector<Target> readTargets(JsonPullReader &r, QString &errorMessage)
+{
+    std::vector<Target> result;
+    r.readArray([&] {
+        Target target;
+        const int members = r.readObject([&](QByteArrayView key) {
+            if (key == "name")
+                target.name = r.readString();
+            else if (key == "id")
+                target.id = r.readString();
+            else if (key == "directoryIndex")
+                target.directory = r.readInt(-1);
+            else if (key == "projectIndex")
+                target.project = r.readInt(-1);
+            else if (key == "jsonFile")
+                target.jsonFile = r.readString();
+            else
+                r.skipValue();
+        });
+        if (members == 0) {
+            errorMessage = Tr::tr(
+                "Invalid codemodel file generated by CMake: Empty target object.");
+            return;
+        }
+        if (target.name.isEmpty() || target.id.isEmpty() || target.jsonFile.isEmpty()
+            || target.directory == -1 || target.project == -1) {
+            errorMessage = Tr::tr(
+                "Invalid codemodel file generated by CMake: Broken target data.");
+            return;
+        }
+
+        result.emplace_back(std::move(target));
+    });
+    return result;
+}
+
+static std::vector<Configuration> parseCodemodelStream(JsonPullReader &r,
+                                                      const FilePath &,
+                                                      QString &errorMessage)
+{
+    QString kind;
+    std::pair<int, int> version{-1, -1};
+    std::vector<Configuration> result;
+    QString configurationsErrorMessage;
+    bool hasBrokenIndexes = false;
+
+    r.readObject([&](QByteArrayView key) {
+        if (key == "kind") {
+            kind = r.readString();
+        } else if (key == "version") {
+            version = readVersion(r);
+        } else if (key == "configurations") {
+            const int count = r.readArray([&] {
+                Configuration config;
+                // Keep the order in which the document reader reports errors:
+                QString directoriesError;
+                QString projectsError;
+                QString targetsError;
+                bool hasDirectories = false;
+                bool hasProjects = false;
+                const int members = r.readObject([&](QByteArrayView key) {
+                    if (key == "name") {
+                        config.name = r.readString();
+                    } else if (key == "directories") {
+                        hasDirectories = true;
+                        config.directories = readDirectories(r, directoriesError);
+                    } else if (key == "projects") {
+                        hasProjects = true;
+                        config.projects = readProjects(r, projectsError);
+                    } else if (key == "targets") {
+                        config.targets = readTargets(r, targetsError);
+                    } else {
+                        r.skipValue();
+                    }
+                });
+                if (members == 0) {
+                    configurationsErrorMessage = Tr::tr(
+                        "Invalid codemodel file generated by CMake: Empty configuration object.");
+                    return;
+                }
+                if (!hasDirectories) {
+                    directoriesError = Tr::tr(
+                        "Invalid codemodel file generated by CMake: No directories.");
+                }
+                if (!hasProjects) {
+                    projectsError = Tr::tr(
+                        "Invalid codemodel file generated by CMake: No projects.");
+                }
+                for (const QString &error : {directoriesError, projectsError, targetsError}) {
+                    if (!error.isEmpty())
+                        configurationsErrorMessage = error;
+                }
+
+                if (hasBrokenIndexes || !validateIndexes(config)) {
+                    hasBrokenIndexes = true;
+                    return;
+                }
+
+                result.emplace_back(std::move(config));
+            });
+            if (count == 0) {
+                configurationsErrorMessage = Tr::tr(
+                    "Invalid codemodel file generated by CMake: No configurations.");
+            }
+        } else {
+            r.skipValue();
+        }
+    });
+
+    if (!r.finish() || !checkKindAndVersion(kind, version, "codemodel", 2)) {
+        errorMessage = Tr::tr("Invalid codemodel file generated by CMake.");
+        return {};
+    }
+    if (hasBrokenIndexes) {
+        errorMessage = Tr::tr("Invalid codemodel file generated by CMake: Broken "
+                              "indexes in directories, projects, or targets.");
+        return {};
+    }
+    if (!configurationsErrorMessage.isEmpty())
+        errorMessage = configurationsErrorMessage;
+    return result;
+}
+
+static bool isSameConfigurations(const std::vector<Configuration> &a,
+                                 const std::vector<Configuration> &b)
+{
+    return isSameList(a, b, [](const Configuration &x, const Configuration &y) {
+        return x.name == y.name
+               && isSameList(x.directories, y.directories,
+                             [](const Directory &d1, const Directory &d2) {
+                                 return d1.buildPath == d2.buildPath
+                                        && d1.sourcePath == d2.sourcePath
+                                        && d1.parent == d2.parent && d1.project == d2.project
+                                        && d1.children == d2.children
+                                        && d1.targets == d2.targets
+                                        && d1.hasInstallRule == d2.hasInstallRule;
+                             })
+               && isSameList(x.projects, y.projects,
+                             [](const Project &p1, const Project &p2) {
+                                 return p1.name == p2.name && p1.parent == p2.parent
+                                        && p1.children == p2.children
+                                        && p1.directories == p2.directories
+                                        && p1.targets == p2.targets;
+                             })
+               && isSameList(x.targets, y.targets, [](const Target &t1, const Target &t2) {
+                      return t1.name == t2.name && t1.id == t2.id
+                             && t1.directory == t2.directory && t1.project == t2.project
+                             && t1.jsonFile == t2.jsonFile;
+                  });
+    });
+}
+
+static std::vector<Configuration> readCodemodelFile(const FilePath &codemodelFile,
+                                                    QString &errorMessage)
+{
+    return readReplyObject(codemodelFile, errorMessage, &parseCodemodelDocument,
+                           &parseCodemodelStream, &isSameConfigurations);
+}
+
 // TargetDetails:
 
 static std::vector<FileApiDetails::FragmentInfo> extractFragments(const QJsonObject &obj)
@@ -507,7 +1020,9 @@ static void addIncludeInfo(std::vector<IncludeInfo> *includes,
     std::copy(add.cbegin(), add.cend(), std::back_inserter(*includes));
 }
 
-static TargetDetails extractTargetDetails(const QJsonObject &root, QString &errorMessage)
+static TargetDetails extractTargetDetails(const QJsonObject &root,
+                                          const FilePath &,
+                                          QString &errorMessage)
 {
     TargetDetails t;
     t.name = root.value("name").toString();
@@ -653,6 +1168,332 @@ static TargetDetails extractTargetDetails(const QJsonObject &root, QString &erro
     return t;
 }
 
+static std::vector<FragmentInfo> readFragments(JsonPullReader &r)
+{
+    std::vector<FragmentInfo> result;
+    r.readArray([&] {
+        FragmentInfo info;
+        r.readObject([&](QByteArrayView key) {
+            if (key == "fragment")
+                info.fragment = r.readString();
+            else if (key == "role")
+                info.role = r.readString();
+            else
+                r.skipValue();
+        });
+        result.emplace_back(std::move(info));
+    });
+    return result;
+}
+
+static void readIncludeInfo(JsonPullReader &r, std::vector<IncludeInfo> *includes)
+{
+    r.readArray([&] {
+        QString path;
+        bool isSystem = false;
+        int backtrace = -1;
+        r.readObject([&](QByteArrayView key) {
+            if (key == "path")
+                path = r.readString();
+            else if (key == "isSystem")
+                isSystem = r.readBool();
+            else if (key == "backtrace")
+                backtrace = r.readInt(-1);
+            else
+                r.skipValue();
+        });
+        const ProjectExplorer::HeaderPath hp(path,
+                                             isSystem ? ProjectExplorer::HeaderPathType::System
+                                                      : ProjectExplorer::HeaderPathType::User);
+        includes->push_back(
+            IncludeInfo{ProjectExplorer::RawProjectPart::frameworkDetectionHeuristic(hp),
+                        backtrace});
+    });
+}
+
+static CompileInfo readCompileGroup(JsonPullReader &r)
+{
+    CompileInfo info;
+    std::vector<IncludeInfo> frameworks;
+    r.readObject([&](QByteArrayView key) {
+        if (key == "sourceIndexes") {
+            info.sources = readIndexList(r);
+        } else if (key == "language") {
+            info.language = r.readString();
+        } else if (key == "compileCommandFragments") {
+            r.readArray([&] {
+                QString fragment;
+                r.readObject([&](QByteArrayView key) {
+                    if (key == "fragment")
+                        fragment = r.readString();
+                    else
+                        r.skipValue();
+                });
+                info.fragments.append(fragment);
+            });
+        } else if (key == "includes") {
+            readIncludeInfo(r, &info.includes);
+        } else if (key == "frameworks") {
+            // new in CMake 3.27+:
+            readIncludeInfo(r, &frameworks);
+        } else if (key == "defines") {
+            r.readArray([&] {
+                QString define;
+                int backtrace = -1;
+                r.readObject([&](QByteArrayView key) {
+                    if (key == "define")
+                        define = r.readString();
+                    else if (key == "backtrace")
+                        backtrace = r.readInt(-1);
+                    else
+                        r.skipValue();
+                });
+                info.defines.push_back(
+                    DefineInfo{ProjectExplorer::Macro::fromKeyValue(define), backtrace});
+            });
+        } else if (key == "sysroot") {
+            info.sysroot = r.readString();
+        } else {
+            r.skipValue();
+        }
+    });
+    std::move(frameworks.begin(), frameworks.end(), std::back_inserter(info.includes));
+    return info;
+}
+
+static TargetDetails extractTargetDetailsStream(JsonPullReader &r,
+                                                const FilePath &,
+                                                QString &errorMessage)
+{
+    TargetDetails t;
+    r.readObject([&](QByteArrayView key) {
+        if (key == "name") {
+            t.name = r.readString();
+        } else if (key == "id") {
+            t.id = r.readString();
+        } else if (key == "type") {
+            t.type = r.readString();
+        } else if (key == "backtrace") {
+            t.backtrace = r.readInt(-1);
+        } else if (key == "folder") {
+            r.readObject([&](QByteArrayView key) {
+                if (key == "name")
+                    t.folderTargetProperty = r.readString();
+                else
+                    r.skipValue();
+            });
+        } else if (key == "paths") {
+            r.readObject([&](QByteArrayView key) {
+                if (key == "source")
+                    t.sourceDir = FilePath::fromString(r.readString());
+                else if (key == "build")
+                    t.buildDir = FilePath::fromString(r.readString());
+                else
+                    r.skipValue();
+            });
+        } else if (key == "nameOnDisk") {
+            t.nameOnDisk = r.readString();
+        } else if (key == "artifacts") {
+            r.readArray([&] { t.artifacts.append(FilePath::fromString(readPathObject(r))); });
+        } else if (key == "isGeneratorProvided") {
+            t.isGeneratorProvided = r.readBool();
+        } else if (key == "install") {
+            r.readObject([&](QByteArrayView key) {
+                if (key == "prefix") {
+                    t.installPrefix = readPathObject(r);
+                } else if (key == "destinations") {
+                    r.readArray([&] {
+                        InstallDestination destination{QString(), -1};
+                        r.readObject([&](QByteArrayView key) {
+                            if (key == "path")
+                                destination.path = r.readString();
+                            else if (key == "backtrace")
+                                destination.backtrace = r.readInt(-1);
+                            else
+                                r.skipValue();
+                        });
+                        t.installDestination.emplace_back(std::move(destination));
+                    });
+                } else {
+                    r.skipValue();
+                }
+            });
+        } else if (key == "link") {
+            LinkInfo info;
+            const int members = r.readObject([&](QByteArrayView key) {
+                if (key == "language")
+                    info.language = r.readString();
+                else if (key == "lto")
+                    info.isLto = r.readBool();
+                else if (key == "sysroot")
+                    info.sysroot = readPathObject(r);
+                else if (key == "commandFragments")
+                    info.fragments = readFragments(r);
+                else
+                    r.skipValue();
+            });
+            if (members > 0)
+                t.link = info;
+        } else if (key == "archive") {
+            ArchiveInfo info;
+            const int members = r.readObject([&](QByteArrayView key) {
+                if (key == "lto")
+                    info.isLto = r.readBool();
+                else if (key == "commandFragments")
+                    info.fragments = readFragments(r);
+                else
+                    r.skipValue();
+            });
+            if (members > 0)
+                t.archive = info;
+        } else if (key == "dependencies") {
+            r.readArray([&] {
+                DependencyInfo dependency{QString(), -1};
+                r.readObject([&](QByteArrayView key) {
+                    if (key == "id")
+                        dependency.targetId = r.readString();
+                    else if (key == "backtrace")
+                        dependency.backtrace = r.readInt(-1);
+                    else
+                        r.skipValue();
+                });
+                t.dependencies.emplace_back(std::move(dependency));
+            });
+        } else if (key == "sources") {
+            r.readArray([&] {
+                SourceInfo source;
+                r.readObject([&](QByteArrayView key) {
+                    if (key == "path")
+                        source.path = r.readString();
+                    else if (key == "compileGroupIndex")
+                        source.compileGroup = r.readInt(-1);
+                    else if (key == "sourceGroupIndex")
+                        source.sourceGroup = r.readInt(-1);
+                    else if (key == "backtrace")
+                        source.backtrace = r.readInt(-1);
+                    else if (key == "isGenerated")
+                        source.isGenerated = r.readBool();
+                    else
+                        r.skipValue();
+                });
+                t.sources.emplace_back(std::move(source));
+            });
+        } else if (key == "sourceGroups") {
+            r.readArray([&] {
+                QString name;
+                r.readObject([&](QByteArrayView key) {
+                    if (key == "name")
+                        name = r.readString();
+                    else
+                        r.skipValue();
+                });
+                t.sourceGroups.emplace_back(std::move(name));
+            });
+        } else if (key == "compileGroups") {
+            r.readArray([&] { t.compileGroups.emplace_back(readCompileGroup(r)); });
+        } else if (key == "backtraceGraph") {
+            r.readObject([&](QByteArrayView key) {
+                if (key == "files") {
+                    r.readArray([&] { t.backtraceGraph.files.emplace_back(r.readString()); });
+                } else if (key == "commands") {
+                    r.readArray([&] { t.backtraceGraph.commands.emplace_back(r.readString()); });
+                } else if (key == "nodes") {
+                    r.readArray([&] {
+                        BacktraceNode node;
+                        r.readObject([&](QByteArrayView key) {
+                            if (key == "file")
+                                node.file = r.readInt(-1);
+                            else if (key == "line")
+                                node.line = r.readInt(-1);
+                            else if (key == "command")
+                                node.command = r.readInt(-1);
+                            else if (key == "parent")
+                                node.parent = r.readInt(-1);
+                            else
+                                r.skipValue();
+                        });
+                        t.backtraceGraph.nodes.push_back(node);
+                    });
+                } else {
+                    r.skipValue();
+                }
+            });
+        } else {
+            r.skipValue();
+        }
+    });
+
+    if (!r.finish() || t.name.isEmpty() || t.id.isEmpty() || t.type.isEmpty()) {
+        errorMessage = Tr::tr("Invalid target file: Information is missing.");
+        return {};
+    }
+    return t;
+}
+
+static bool isSameFragments(const std::vector<FragmentInfo> &a, const std::vector<FragmentInfo> &b)
+{
+    return isSameList(a, b, [](const FragmentInfo &x, const FragmentInfo &y) {
+        return x.fragment == y.fragment && x.role == y.role;
+    });
+}
+
+static bool isSameTargetDetails(const TargetDetails &a, const TargetDetails &b)
+{
+    const bool sameLink = a.link.has_value() == b.link.has_value()
+                          && (!a.link
+                              || (a.link->language == b.link->language
+                                  && a.link->isLto == b.link->isLto
+                                  && a.link->sysroot == b.link->sysroot
+                                  && isSameFragments(a.link->fragments, b.link->fragments)));
+    const bool sameArchive = a.archive.has_value() == b.archive.has_value()
+                             && (!a.archive
+                                 || (a.archive->isLto == b.archive->isLto
+                                     && isSameFragments(a.archive->fragments,
+                                                        b.archive->fragments)));
+    const auto sameCompileGroup = [](const CompileInfo &x, const CompileInfo &y) {
+        return x.sources == y.sources && x.language == y.language && x.fragments == y.fragments
+               && x.sysroot == y.sysroot
+               && isSameList(x.includes, y.includes,
+                             [](const IncludeInfo &i1, const IncludeInfo &i2) {
+                                 return i1.path == i2.path && i1.backtrace == i2.backtrace;
+                             })
+               && isSameList(x.defines, y.defines, [](const DefineInfo &d1, const DefineInfo &d2) {
+                      return d1.define == d2.define && d1.backtrace == d2.backtrace;
+                  });
+    };
+
+    return a.name == b.name && a.id == b.id && a.type == b.type
+           && a.folderTargetProperty == b.folderTargetProperty && a.sourceDir == b.sourceDir
+           && a.buildDir == b.buildDir && a.backtrace == b.backtrace
+           && a.isGeneratorProvided == b.isGeneratorProvided && a.nameOnDisk == b.nameOnDisk
+           && a.artifacts == b.artifacts && a.installPrefix == b.installPrefix
+           && isSameList(a.installDestination, b.installDestination,
+                         [](const InstallDestination &x, const InstallDestination &y) {
+                             return x.path == y.path && x.backtrace == y.backtrace;
+                         })
+           && sameLink && sameArchive
+           && isSameList(a.dependencies, b.dependencies,
+                         [](const DependencyInfo &x, const DependencyInfo &y) {
+                             return x.targetId == y.targetId && x.backtrace == y.backtrace;
+                         })
+           && isSameList(a.sources, b.sources,
+                         [](const SourceInfo &x, const SourceInfo &y) {
+                             return x.path == y.path && x.compileGroup == y.compileGroup
+                                    && x.sourceGroup == y.sourceGroup
+                                    && x.backtrace == y.backtrace
+                                    && x.isGenerated == y.isGenerated;
+                         })
+           && a.sourceGroups == b.sourceGroups
+           && isSameList(a.compileGroups, b.compileGroups, sameCompileGroup)
+           && a.backtraceGraph.files == b.backtraceGraph.files
+           && a.backtraceGraph.commands == b.backtraceGraph.commands
+           && isSameList(a.backtraceGraph.nodes, b.backtraceGraph.nodes,
+                         [](const BacktraceNode &x, const BacktraceNode &y) {
+                             return x.file == y.file && x.line == y.line
+                                    && x.command == y.command && x.parent == y.parent;
+                         });
+}
+
 static int validateBacktraceGraph(const TargetDetails &t)
 {
     const int backtraceFilesCount = static_cast<int>(t.backtraceGraph.files.size());
@@ -768,10 +1609,8 @@ static bool validateTargetDetails(const TargetDetails &t)
 
 static TargetDetails readTargetFile(const FilePath &targetFile, QString &errorMessage)
 {
-    const QJsonDocument doc = readJsonFile(targetFile);
-    const QJsonObject root = doc.object();
-
-    TargetDetails result = extractTargetDetails(root, errorMessage);
+    TargetDetails result = readReplyObject(targetFile, errorMessage, &extractTargetDetails,
+                                           &extractTargetDetailsStream, &isSameTargetDetails);
     if (errorMessage.isEmpty() && !validateTargetDetails(result)) {
         errorMessage = Tr::tr(
             "Invalid target file generated by CMake: Broken indexes in target details.");
@@ -822,6 +1661,40 @@ bool FileApiParser::setupCMakeFileApi(const FilePath &buildDirectory)
     return true;
 }
 
+class TargetFileResult
+{
+public:
+    QString file;
+    TargetDetails details;
+    QString errorMessage;
+};
+
+// Lets all targets share the storage of their compile groups, see FileApiStringPool:
+static void internStrings(FileApiStringPool &pool, TargetDetails &t)
+{
+    for (CompileInfo &ci : t.compileGroups) {
+        ci.language = pool.string(ci.language);
+        ci.fragments = pool.stringList(ci.fragments);
+        for (IncludeInfo &i : ci.includes)
+            i.path.path = pool.string(i.path.path);
+        for (DefineInfo &d : ci.defines) {
+            d.define.key = pool.bytes(d.define.key);
+            d.define.value = pool.bytes(d.define.value);
+        }
+        ci.sysroot = pool.string(ci.sysroot);
+    }
+    if (t.link) {
+        for (FragmentInfo &f : t.link->fragments) {
+            f.fragment = pool.string(f.fragment);
+            f.role = pool.string(f.role);
+        }
+    }
+    for (QString &command : t.backtraceGraph.commands)
+        command = pool.string(command);
+    for (QString &file : t.backtraceGraph.files)
+        file = pool.string(file);
+}
+
 static QStringList uniqueTargetFiles(const Configuration &config)
 {
     QSet<QString> knownIds;
@@ -836,15 +1709,120 @@ static QStringList uniqueTargetFiles(const Configuration &config)
     return files;
 }
 
+static std::shared_ptr<const FileApiReplyCache> readReplyDirectory(
+    QPromise<std::shared_ptr<FileApiQtcData>> &promise,
+    const FilePath &replyFilePath,
+    const std::shared_ptr<const FileApiTargetCache> &targetCache,
+    ParseTimings *timings,
+    QString &errorMessage)
+{
+    const FilePath replyDir = replyFilePath.parentDir();
+
+    auto reply = std::make_shared<FileApiReplyCache>();
+    reply->replyFilePath = replyFilePath;
+    reply->replyTimestamp = replyFilePath.lastModified();
+
+    {
+        ParseTimings::Phase phase(timings, "readReplyFile");
+        reply->replyFile = readReplyFile(replyFilePath, errorMessage);
+        phase.setCount(reply->replyFile.replies.size());
+    }
+    if (promise.isCanceled())
+        return {};
+    {
+        ParseTimings::Phase phase(timings, "readCacheFile");
+        reply->cache = readCacheFile(reply->replyFile.jsonFile("cache", replyDir), errorMessage);
+        phase.setCount(reply->cache.size());
+    }
+    if (promise.isCanceled())
+        return {};
+    {
+        ParseTimings::Phase phase(timings, "readCMakeFilesFile");
+        reply->cmakeFiles = readCMakeFilesFile(reply->replyFile.jsonFile("cmakeFiles", replyDir),
+                                               errorMessage);
+        phase.setCount(qsizetype(reply->cmakeFiles.size()));
+    }
+    if (promise.isCanceled())
+        return {};
+    {
+        ParseTimings::Phase phase(timings, "readCodemodelFile");
+        reply->configurations = readCodemodelFile(reply->replyFile.jsonFile("codemodel", replyDir),
+                                                  errorMessage);
+        phase.setCount(qsizetype(reply->configurations.size()));
+    }
+    if (promise.isCanceled() || reply->configurations.size() < 2)
+        return reply;
+
+    ParseTimings::Phase phase(timings, "Read targets of all configurations");
+
+    // Multi-config generators: Read the targets of all configurations up front, so that
+    // switching the build type does not need to touch the reply directory again.
+    QStringList targetFiles;
+    QSet<QString> knownFiles;
+    for (const Configuration &config : reply->configurations) {
+        for (const QString &file : uniqueTargetFiles(config)) {
+            if (targetCache && targetCache->targets.contains(file))
+                continue;
+            if (knownFiles.contains(file))
+                continue;
+            knownFiles.insert(file);
+            targetFiles.append(file);
+        }
+    }
+
+    QFuture<TargetFileResult> mapResult
+        = QtConcurrent::mapped(targetFiles, [&promise, &replyDir](const QString &targetFile) {
+              TargetFileResult r;
+              r.file = targetFile;
+              if (!promise.isCanceled()) {
+                  r.details = readTargetFile((replyDir / targetFile).absoluteFilePath(),
+                                             r.errorMessage);
+              }
+              return r;
+          });
+    mapResult.waitForFinished();
+    if (promise.isCanceled())
+        return {};
+
+    // Broken target files are left out, they are read again (and reported) when needed:
+    QList<TargetFileResult> targetResults = mapResult.results();
+    phase.setCount(targetResults.size());
+    reply->targetDetails.reserve(targetResults.size());
+    for (TargetFileResult &r : targetResults) {
+        if (r.errorMessage.isEmpty())
+            reply->targetDetails.insert(r.file,
+                                        std::make_shared<const TargetDetails>(std::move(r.details)));
+    }
+    return reply;
+}
+
 FileApiData FileApiParser::parseData(QPromise<std::shared_ptr<FileApiQtcData>> &promise,
                                      const FilePath &replyFilePath,
                                      const QString &cmakeBuildType,
+                                     const std::shared_ptr<const FileApiTargetCache> &targetCache,
+                                     const std::shared_ptr<const FileApiReplyCache> &replyCache,
+                                     ParseTimings *timings,
                                      QString &errorMessage)
+{
+    FileApiData result = parseCodemodel(promise, replyFilePath, cmakeBuildType, targetCache,
+                                        replyCache, timings, errorMessage);
+    if (errorMessage.isEmpty())
+        loadTargetDetails(promise, result, errorMessage);
+    return result;
+}
+
+FileApiData FileApiParser::parseCodemodel(QPromise<std::shared_ptr<FileApiQtcData>> &promise,
+                                          const FilePath &replyFilePath,
+                                          const QString &cmakeBuildType,
+                                          const std::shared_ptr<const FileApiTargetCache> &targetCache,
+                                          const std::shared_ptr<const FileApiReplyCache> &replyCache,
+                                          ParseTimings *timings,
+                                          QString &errorMessage)
 {
     QTC_CHECK(errorMessage.isEmpty());
-    const FilePath replyDir = replyFilePath.parentDir();
 
     FileApiData result;
+    result.timings = timings;
 
     const auto cancelCheck = [&promise, &errorMessage] {
         if (promise.isCanceled()) {
@@ -854,18 +1832,19 @@ FileApiData FileApiParser::parseData(QPromise<std::shared_ptr<FileApiQtcData>> &
         return false;
     };
 
-    result.replyFile = readReplyFile(replyFilePath, errorMessage);
-    if (cancelCheck())
-        return {};
-    result.cache = readCacheFile(result.replyFile.jsonFile("cache", replyDir), errorMessage);
-    if (cancelCheck())
-        return {};
-    result.cmakeFiles = readCMakeFilesFile(result.replyFile.jsonFile("cmakeFiles", replyDir),
-                                           errorMessage);
-    if (cancelCheck())
-        return {};
-    auto codeModels = readCodemodelFile(result.replyFile.jsonFile("codemodel", replyDir),
-                                         errorMessage);
+    // A new CMake run always writes a new reply index file:
+    std::shared_ptr<const FileApiReplyCache> reply = replyCache;
+    if (!reply || reply->replyFilePath != replyFilePath
+        || reply->replyTimestamp != replyFilePath.lastModified()) {
+        reply = readReplyDirectory(promise, replyFilePath, targetCache, timings, errorMessage);
+        if (cancelCheck())
+            return {};
+    }
+
+    result.replyFile = reply->replyFile;
+    result.cache = reply->cache;
+    result.cmakeFiles = reply->cmakeFiles;
+    const std::vector<Configuration> &codeModels = reply->configurations;
 
     if (codeModels.size() == 0) {
         errorMessage = Tr::tr("CMake project configuration failed. No CMake configuration for "
@@ -896,27 +1875,83 @@ FileApiData FileApiParser::parseData(QPromise<std::shared_ptr<FileApiQtcData>> &
         }
         return result;
     }
-    result.codemodel = std::move(*it);
+    result.codemodel = *it;
+    result.replyCache = reply;
+    result.targetCache = targetCache;
     if (cancelCheck())
         return {};
 
+    return result;
+}
+
+qsizetype FileApiParser::unreadTargetCount(const FileApiData &data)
+{
+    const QStringList targetFiles = uniqueTargetFiles(data.codemodel);
+    return std::count_if(targetFiles.cbegin(), targetFiles.cend(), [&data](const QString &file) {
+        return !(data.targetCache && data.targetCache->targets.contains(file))
+               && !(data.replyCache && data.replyCache->targetDetails.contains(file));
+    });
+}
+
+void FileApiParser::loadTargetDetails(QPromise<std::shared_ptr<FileApiQtcData>> &promise,
+                                      FileApiData &result,
+                                      QString &errorMessage)
+{
+    QTC_ASSERT(result.replyCache, return);
+    const FilePath replyDir = result.replyCache->replyFilePath.parentDir();
+    const std::shared_ptr<const FileApiTargetCache> &targetCache = result.targetCache;
+    const std::shared_ptr<const FileApiReplyCache> &reply = result.replyCache;
+
     const QStringList targetFiles = uniqueTargetFiles(result.codemodel);
+    ParseTimings::Phase phase(result.timings, "Target loop");
+    phase.setCount(targetFiles.size());
+
+    // Load and validate the target files. We use concurrency here since big projects
+    // can have thousands of them. The mapped results keep the order of targetFiles.
+    // Target files that were already read by the previous parse are taken from the cache,
+    // their names change whenever their contents change.
+    QFuture<TargetFileResult> mapResult
+        = QtConcurrent::mapped(targetFiles,
+                               [&promise, &replyDir, &targetCache, &reply](const QString &targetFile) {
+              TargetFileResult r;
+              r.file = targetFile;
+              if (promise.isCanceled())
+                  return r;
+              if (targetCache) {
+                  if (const auto cached = targetCache->targets.value(targetFile)) {
+                      r.details = *cached->details;
+                      return r;
+                  }
+              }
+              const auto prefetched = reply->targetDetails.constFind(targetFile);
+              if (prefetched != reply->targetDetails.constEnd()) {
+                  r.details = **prefetched;
+                  return r;
+              }
+              r.details = readTargetFile((replyDir / targetFile).absoluteFilePath(),
+                                         r.errorMessage);
+              return r;
+          });
 
-    for (const QString &targetFile : targetFiles) {
-        if (cancelCheck())
-            return {};
-        QString targetErrorMessage;
-        TargetDetails td = readTargetFile((replyDir / targetFile).absoluteFilePath(), targetErrorMessage);
-        if (targetErrorMessage.isEmpty()) {
-            result.targetDetails.emplace_back(std::move(td));
+    mapResult.waitForFinished();
+
+    if (promise.isCanceled()) {
+        errorMessage = Tr::tr("CMake parsing was canceled.");
+        return;
+    }
+
+    QList<TargetFileResult> targetResults = mapResult.results();
+    for (TargetFileResult &r : targetResults) {
+        if (r.errorMessage.isEmpty()) {
+            internStrings(result.stringPool, r.details);
+            result.targetDetails.emplace_back(std::move(r.details));
+            result.targetFiles.append(r.file);
         } else {
             qWarning() << "Failed to retrieve target data from cmake fileapi:"
-                       << targetErrorMessage;
-            errorMessage = targetErrorMessage;
+                       << r.errorMessage;
+            errorMessage = r.errorMessage;
         }
     }
-
-    return result;
 }
 
 FilePath FileApiParser::scanForCMakeReplyFile(const FilePath &buildDirectory)
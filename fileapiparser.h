@@ -6,6 +6,7 @@
 #include "cmakeconfigitem.h"
 
 #include "fileapidataextractor.h"
+#include "fileapistringpool.h"
 
 #include <projectexplorer/headerpath.h>
 #include <projectexplorer/projectmacro.h>
@@ -13,10 +14,14 @@
 #include <utils/filesystemwatcher.h>
 #include <utils/fileutils.h>
 
+#include <QDateTime>
+#include <QHash>
 #include <QString>
 #include <QVector>
 #include <QVersionNumber>
 
+#include <memory>
+#include <optional>
 #include <vector>
 
 QT_BEGIN_NAMESPACE
@@ -26,6 +31,8 @@ QT_END_NAMESPACE
 
 namespace CMakeProjectManager::Internal {
 
+class ParseTimings;
+
 namespace FileApiDetails {
 
 class ReplyObject
@@ -208,6 +215,41 @@ public:
 
 } // namespace FileApiDetails
 
+class CachedTarget
+{
+public:
+    // Shared with the FileApiReplyCache, if the reply cache has the target
+    std::shared_ptr<const FileApiDetails::TargetDetails> details;
+    CMakeBuildTarget buildTarget;
+    // Not set for targets using precompiled headers, these need to be regenerated:
+    std::optional<ProjectExplorer::RawProjectParts> projectParts;
+};
+
+class FileApiTargetCache
+{
+public:
+    bool relativeLibs = false;
+    // Keyed by the name of the target reply file, which contains a hash of its contents:
+    QHash<QString, std::shared_ptr<const CachedTarget>> targets;
+};
+
+// The parsed contents of one reply directory, for all configurations of a multi-config
+// generator. Switching the build type then only needs to pick another configuration.
+class FileApiReplyCache
+{
+public:
+    Utils::FilePath replyFilePath;
+    QDateTime replyTimestamp;
+
+    FileApiDetails::ReplyFileContents replyFile;
+    CMakeConfig cache;
+    std::vector<CMakeFileInfo> cmakeFiles;
+    std::vector<FileApiDetails::Configuration> configurations;
+    // Target details of all configurations, keyed by the name of their target reply file. The
+    // FileApiTargetCache shares these, instead of holding copies:
+    QHash<QString, std::shared_ptr<const FileApiDetails::TargetDetails>> targetDetails;
+};
+
 class FileApiData
 {
 public:
@@ -216,6 +258,12 @@ public:
     std::vector<CMakeFileInfo> cmakeFiles;
     FileApiDetails::Configuration codemodel;
     std::vector<FileApiDetails::TargetDetails> targetDetails;
+    QStringList targetFiles; // Reply file names of targetDetails
+    std::shared_ptr<const FileApiTargetCache> targetCache;
+    std::shared_ptr<const FileApiReplyCache> replyCache;
+    std::shared_ptr<const CMakeFileCache> cmakeFileCache;
+    FileApiStringPool stringPool; // Holds the values of targetDetails
+    ParseTimings *timings = nullptr;
 };
 
 class FileApiParser
@@ -224,8 +272,26 @@ public:
     static FileApiData parseData(QPromise<std::shared_ptr<FileApiQtcData>> &promise,
                                  const Utils::FilePath &replyFilePath,
                                  const QString &cmakeBuildType,
+                                 const std::shared_ptr<const FileApiTargetCache> &targetCache,
+                                 const std::shared_ptr<const FileApiReplyCache> &replyCache,
+                                 ParseTimings *timings,
                                  QString &errorMessage);
 
+    // The two halves of parseData: Reads everything but the target files, which are
+    // loaded into the result by loadTargetDetails.
+    static FileApiData parseCodemodel(QPromise<std::shared_ptr<FileApiQtcData>> &promise,
+                                      const Utils::FilePath &replyFilePath,
+                                      const QString &cmakeBuildType,
+                                      const std::shared_ptr<const FileApiTargetCache> &targetCache,
+                                      const std::shared_ptr<const FileApiReplyCache> &replyCache,
+                                      ParseTimings *timings,
+                                      QString &errorMessage);
+    static void loadTargetDetails(QPromise<std::shared_ptr<FileApiQtcData>> &promise,
+                                  FileApiData &data,
+                                  QString &errorMessage);
+    // Number of target files loadTargetDetails has to read from disk
+    static qsizetype unreadTargetCount(const FileApiData &data);
+
     static bool setupCMakeFileApi(const Utils::FilePath &buildDirectory);
 
     static Utils::FilePath cmakeReplyDirectory(const Utils::FilePath &buildDirectory);
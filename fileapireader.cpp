@@ -3,11 +3,13 @@
 
 #include "fileapireader.h"
 
+#include "cmakeparsetimings.h"
 #include "cmakeprocess.h"
 #include "cmakeprojectmanagertr.h"
 #include "cmakespecificsettings.h"
 #include "fileapidataextractor.h"
 #include "fileapiparser.h"
+#include "fileapisnapshot.h"
 
 #include <coreplugin/messagemanager.h>
 
@@ -32,6 +34,9 @@ Q_LOGGING_CATEGORY(cmakeFileApiMode, "qtc.cmake.fileApiMode", QtWarningMsg);
 
 using namespace FileApiDetails;
 
+// Projects with at least this many target files to read get a preview of their tree
+const int PreviewTargetCount = 200;
+
 // --------------------------------------------------------------------
 // FileApiReader:
 // --------------------------------------------------------------------
@@ -56,6 +61,13 @@ void FileApiReader::setParameters(const BuildDirParameters &p)
     qCDebug(cmakeFileApiMode)
         << "\n\n\n\n\n=============================================================\n";
 
+    // Cached targets depend on the source and build directory:
+    if (p.sourceDirectory != m_parameters.sourceDirectory
+        || p.buildDirectory != m_parameters.buildDirectory) {
+        m_targetCache.reset();
+        m_replyCache.reset();
+    }
+
     // Update:
     m_parameters = p;
     qCDebug(cmakeFileApiMode) << "Work directory:" << m_parameters.buildDirectory.toUserOutput();
@@ -82,6 +94,7 @@ void FileApiReader::resetData()
     m_buildTargets.clear();
     m_projectParts.clear();
     m_rootProjectNode.reset();
+    m_previewProjectNode.reset();
 }
 
 void FileApiReader::parse(bool forceCMakeRun,
@@ -121,7 +134,11 @@ void FileApiReader::parse(bool forceCMakeRun,
 
     qCDebug(cmakeFileApiMode) << "Parameters request these CMake arguments:" << args;
 
-    const FilePath replyFile = FileApiParser::scanForCMakeReplyFile(m_parameters.buildDirectory);
+    FilePath replyFile;
+    {
+        ParseTimings::Phase phase(m_parseTimings.get(), "scanForCMakeReplyFile");
+        replyFile = FileApiParser::scanForCMakeReplyFile(m_parameters.buildDirectory);
+    }
     // Only need to update when one of the following conditions is met:
     //  * The user forces the cmake run,
     //  * The user provided arguments,
@@ -239,6 +256,7 @@ void FileApiReader::startState()
     QTC_ASSERT(!m_future.has_value(), return );
 
     m_isParsing = true;
+    m_parseTimings = std::make_shared<ParseTimings>();
 
     qCDebug(cmakeFileApiMode) << "FileApiReader: CONFIGURATION STARTED SIGNAL";
     emit configurationStarted();
@@ -257,17 +275,63 @@ void FileApiReader::endState(const FilePath &replyFilePath, bool restoredFromBac
 
     m_lastReplyTimestamp = replyFilePath.lastModified();
 
+    FileApiSnapshot::Key snapshotKey;
+    snapshotKey.replyFileName = replyFilePath.fileName();
+    snapshotKey.replyTimestamp = m_lastReplyTimestamp;
+    snapshotKey.sourceDirectory = sourceDirectory;
+    snapshotKey.buildDirectory = buildDirectory;
+    snapshotKey.cmakeBuildType = cmakeBuildType;
+    snapshotKey.isPlain = m_isPlain;
+
     m_future = Utils::asyncRun(ProjectExplorerPlugin::sharedThreadPool(),
-                        [replyFilePath, sourceDirectory, buildDirectory, cmakeBuildType, isPlain = m_isPlain](
+                        [replyFilePath, sourceDirectory, buildDirectory, cmakeBuildType, isPlain = m_isPlain,
+                         targetCache = m_targetCache, replyCache = m_replyCache,
+                         cmakeFileCache = m_cmakeFileCache, snapshotKey,
+                         restoredFromBackup, timings = m_parseTimings,
+                         showPreview = settings().loadTargetsInBackground()](
                             QPromise<std::shared_ptr<FileApiQtcData>> &promise) {
                             auto result = std::make_shared<FileApiQtcData>();
-                            FileApiData data = FileApiParser::parseData(promise,
-                                                                        replyFilePath,
-                                                                        cmakeBuildType,
-                                                                        result->errorMessage);
+                            const QFuture<void> cancelFuture(promise.future());
+                            const bool useSnapshot = FileApiSnapshot::isSupported(buildDirectory);
+
+                            FileApiData data;
+                            bool snapshotRead = false;
+                            if (useSnapshot) {
+                                ParseTimings::Phase phase(timings.get(), "Read snapshot");
+                                snapshotRead = FileApiSnapshot::read(snapshotKey, data, *result);
+                                data.timings = timings.get();
+                            }
+                            if (snapshotRead) {
+                                qCDebug(cmakeFileApiMode) << "FileApiReader: Using snapshot.";
+                                restoreProjectTree(cancelFuture, data, *result,
+                                                   sourceDirectory, buildDirectory, isPlain);
+                                promise.addResult(result);
+                                return;
+                            }
+
+                            data = FileApiParser::parseCodemodel(promise,
+                                                                 replyFilePath,
+                                                                 cmakeBuildType,
+                                                                 targetCache,
+                                                                 replyCache,
+                                                                 timings.get(),
+                                                                 result->errorMessage);
+                            if (result->errorMessage.isEmpty() && showPreview
+                                && FileApiParser::unreadTargetCount(data) >= PreviewTargetCount) {
+                                // Show the tree while the target files are being read:
+                                auto preview = std::make_shared<FileApiQtcData>();
+                                preview->isPreview = true;
+                                preview->rootProjectNode = generatePreviewTree(
+                                    cancelFuture, data, sourceDirectory, buildDirectory, isPlain);
+                                if (preview->rootProjectNode)
+                                    promise.addResult(preview);
+                            }
+                            if (result->errorMessage.isEmpty())
+                                FileApiParser::loadTargetDetails(promise, data, result->errorMessage);
                             qCDebug(cmakeFileApiMode) << "FileApiReader: isPlain" << isPlain;
                             if (result->errorMessage.isEmpty()) {
-                                *result = extractData(QFuture<void>(promise.future()), data,
+                                data.cmakeFileCache = cmakeFileCache;
+                                *result = extractData(cancelFuture, data,
                                                       sourceDirectory, buildDirectory, isPlain);
                             } else {
                                 qWarning() << result->errorMessage;
@@ -277,9 +341,19 @@ void FileApiReader::endState(const FilePath &replyFilePath, bool restoredFromBac
                         });
     onResultReady(m_future.value(),
                   this,
-                  [this, sourceDirectory, buildDirectory, restoredFromBackup](
+                  [this, sourceDirectory, buildDirectory, restoredFromBackup, snapshotKey](
                       const std::shared_ptr<FileApiQtcData> &value) {
+                      if (value->isPreview) {
+                          m_previewProjectNode = std::move(value->rootProjectNode);
+                          emit this->previewAvailable();
+                          return;
+                      }
+                      if (!value->isRestored && !restoredFromBackup && value->errorMessage.isEmpty()
+                          && value->codemodel && FileApiSnapshot::isSupported(buildDirectory)) {
+                          FileApiSnapshot::writeInBackground(snapshotKey, *value);
+                      }
                       m_isParsing = false;
+                      m_previewProjectNode.reset();
                       m_cache = std::move(value->cache);
                       m_cmakeFiles = std::move(value->cmakeFiles);
                       m_buildTargets = std::move(value->buildTargets);
@@ -288,6 +362,12 @@ void FileApiReader::endState(const FilePath &replyFilePath, bool restoredFromBac
                       m_ctestPath = std::move(value->ctestPath);
                       m_isMultiConfig = value->isMultiConfig;
                       m_usesAllCapsTargets = value->usesAllCapsTargets;
+                      if (value->targetCache)
+                          m_targetCache = std::move(value->targetCache);
+                      if (value->replyCache)
+                          m_replyCache = std::move(value->replyCache);
+                      if (value->cmakeFileCache)
+                          m_cmakeFileCache = std::move(value->cmakeFileCache);
 
                       if (value->errorMessage.isEmpty()) {
                           emit this->dataAvailable(restoredFromBackup);
@@ -350,11 +430,21 @@ std::unique_ptr<CMakeProjectNode> FileApiReader::rootProjectNode()
     return std::exchange(m_rootProjectNode, {});
 }
 
+std::unique_ptr<CMakeProjectNode> FileApiReader::takePreviewProjectNode()
+{
+    return std::exchange(m_previewProjectNode, {});
+}
+
 FilePath FileApiReader::topCmakeFile() const
 {
     return m_cmakeFiles.size() == 1 ? (*m_cmakeFiles.begin()).path : FilePath{};
 }
 
+std::shared_ptr<ParseTimings> FileApiReader::takeParseTimings()
+{
+    return std::exchange(m_parseTimings, {});
+}
+
 int FileApiReader::lastCMakeExitCode() const
 {
     return m_lastCMakeExitCode;
@@ -380,6 +470,7 @@ void FileApiReader::startCMakeState(const QStringList &configurationArguments)
 
     makeBackupConfiguration(true);
     writeConfigurationIntoBuildDirectory(configurationArguments);
+    m_cmakeRunStart = m_parseTimings ? m_parseTimings->elapsedNs() : 0;
     m_cmakeProcess->run(m_parameters, configurationArguments);
 }
 
@@ -389,6 +480,10 @@ void FileApiReader::cmakeFinishedState(int exitCode)
 
     m_lastCMakeExitCode = exitCode;
     m_cmakeProcess.release()->deleteLater();
+    if (m_parseTimings)
+        m_parseTimings->record("CMake run",
+                               m_cmakeRunStart,
+                               m_parseTimings->elapsedNs() - m_cmakeRunStart);
 
     if (m_lastCMakeExitCode != 0)
         makeBackupConfiguration(false);
@@ -398,8 +493,12 @@ void FileApiReader::cmakeFinishedState(int exitCode)
     m_watcher.addDirectory(FileApiParser::cmakeReplyDirectory(m_parameters.buildDirectory).path(),
                            FileSystemWatcher::WatchAllChanges);
 
-    endState(FileApiParser::scanForCMakeReplyFile(m_parameters.buildDirectory),
-             m_lastCMakeExitCode != 0);
+    FilePath replyFile;
+    {
+        ParseTimings::Phase phase(m_parseTimings.get(), "scanForCMakeReplyFile");
+        replyFile = FileApiParser::scanForCMakeReplyFile(m_parameters.buildDirectory);
+    }
+    endState(replyFile, m_lastCMakeExitCode != 0);
 }
 
 void FileApiReader::replyDirectoryHasChanged(const QString &directory) const
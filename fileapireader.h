@@ -26,6 +26,9 @@ namespace CMakeProjectManager::Internal {
 
 class CMakeProcess;
 class FileApiQtcData;
+class FileApiReplyCache;
+class FileApiTargetCache;
+class ParseTimings;
 
 class FileApiReader : public QObject
 {
@@ -60,13 +63,19 @@ public:
 
     int lastCMakeExitCode() const;
 
+    // Timings of the last parse, to be completed by the caller
+    std::shared_ptr<ParseTimings> takeParseTimings();
+
     std::unique_ptr<CMakeProjectNode> rootProjectNode();
+    // Tree without target sources, available while the target files are still loaded
+    std::unique_ptr<CMakeProjectNode> takePreviewProjectNode();
 
     Utils::FilePath topCmakeFile() const;
 
 signals:
     void configurationStarted() const;
     void dataAvailable(bool restoredFromBackup) const;
+    void previewAvailable() const;
     void dirty() const;
     void errorOccurred(const QString &message) const;
     void debuggingStarted() const;
@@ -90,6 +99,7 @@ protected:
     QList<CMakeBuildTarget> m_buildTargets;
     ProjectExplorer::RawProjectParts m_projectParts;
     std::unique_ptr<CMakeProjectNode> m_rootProjectNode;
+    std::unique_ptr<CMakeProjectNode> m_previewProjectNode;
     QString m_ctestPath;
     bool m_isMultiConfig = false;
     bool m_usesAllCapsTargets = false;
@@ -98,8 +108,17 @@ protected:
 
     std::optional<QFuture<std::shared_ptr<FileApiQtcData>>> m_future;
 
+    // Targets of the last parse, reused for unchanged target reply files:
+    std::shared_ptr<const FileApiTargetCache> m_targetCache;
+    // Contents of the last reply directory, for switching between multi-config build types:
+    std::shared_ptr<const FileApiReplyCache> m_replyCache;
+    // Parsed CMake files of the last parse, including the modules of the CMake installation:
+    std::shared_ptr<const CMakeFileCache> m_cmakeFileCache;
+
     // Update related:
     bool m_isParsing = false;
+    std::shared_ptr<ParseTimings> m_parseTimings;
+    qint64 m_cmakeRunStart = 0;
     BuildDirParameters m_parameters;
 
     // Notification on changes outside of creator:
@@ -0,0 +1,986 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "fileapisnapshot.h"
+
+#include "fileapidataextractor.h"
+#include "fileapiparser.h"
+#include "fileapistringpool.h"
+
+#include <extensionsystem/pluginmanager.h>
+
+#include <projectexplorer/projectexplorer.h>
+
+#include <utils/algorithm.h>
+#include <utils/async.h>
+#include <utils/futuresynchronizer.h>
+#include <utils/qtcassert.h>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QSaveFile>
+#include <QSet>
+
+using namespace ProjectExplorer;
+using namespace Utils;
+
+namespace CMakeProjectManager::Internal {
+
+using namespace FileApiDetails;
+
+static Q_LOGGING_CATEGORY(cmakeSnapshot, "qtc.cmake.fileApiSnapshot", QtWarningMsg);
+
+const char SNAPSHOT_RELATIVE_PATH[] = ".qtc/cmake-fileapi.snapshot";
+const quint32 SNAPSHOT_MAGIC = 0x51434653; // "QCFS"
+const quint32 SNAPSHOT_VERSION = 2;
+const quint32 SNAPSHOT_END_MARKER = 0x454e4421; // "END!"
+
+// --------------------------------------------------------------------
+// Serialization helpers:
+// --------------------------------------------------------------------
+
+namespace {
+
+void save(QDataStream &s, bool v) { s << v; }
+void load(QDataStream &s, bool &v) { s >> v; }
+void save(QDataStream &s, int v) { s << qint32(v); }
+void load(QDataStream &s, int &v) { qint32 i = 0; s >> i; v = i; }
+void save(QDataStream &s, long v) { s << qint64(v); }
+void load(QDataStream &s, long &v) { qint64 i = 0; s >> i; v = long(i); }
+void save(QDataStream &s, const QString &v) { s << v; }
+void load(QDataStream &s, QString &v) { s >> v; }
+void save(QDataStream &s, const QByteArray &v) { s << v; }
+void load(QDataStream &s, QByteArray &v) { s >> v; }
+void save(QDataStream &s, const std::string &v) { s << QByteArray::fromStdString(v); }
+void load(QDataStream &s, std::string &v) { QByteArray b; s >> b; v = b.toStdString(); }
+void save(QDataStream &s, const FilePath &v) { s << v.toString(); }
+void load(QDataStream &s, FilePath &v) { QString p; s >> p; v = FilePath::fromString(p); }
+
+void save(QDataStream &s, const Directory &v);
+void load(QDataStream &s, Directory &v);
+void save(QDataStream &s, const Project &v);
+void load(QDataStream &s, Project &v);
+void save(QDataStream &s, const Target &v);
+void load(QDataStream &s, Target &v);
+void save(QDataStream &s, const Configuration &v);
+void load(QDataStream &s, Configuration &v);
+void save(QDataStream &s, const InstallDestination &v);
+void load(QDataStream &s, InstallDestination &v);
+void save(QDataStream &s, const FragmentInfo &v);
+void load(QDataStream &s, FragmentInfo &v);
+void save(QDataStream &s, const LinkInfo &v);
+void load(QDataStream &s, LinkInfo &v);
+void save(QDataStream &s, const ArchiveInfo &v);
+void load(QDataStream &s, ArchiveInfo &v);
+void save(QDataStream &s, const DependencyInfo &v);
+void load(QDataStream &s, DependencyInfo &v);
+void save(QDataStream &s, const SourceInfo &v);
+void load(QDataStream &s, SourceInfo &v);
+void save(QDataStream &s, const IncludeInfo &v);
+void load(QDataStream &s, IncludeInfo &v);
+void save(QDataStream &s, const DefineInfo &v);
+void load(QDataStream &s, DefineInfo &v);
+void save(QDataStream &s, const CompileInfo &v);
+void load(QDataStream &s, CompileInfo &v);
+void save(QDataStream &s, const BacktraceNode &v);
+void load(QDataStream &s, BacktraceNode &v);
+void save(QDataStream &s, const TargetDetails &v);
+void load(QDataStream &s, TargetDetails &v);
+void save(QDataStream &s, const HeaderPath &v);
+void load(QDataStream &s, HeaderPath &v);
+void save(QDataStream &s, const Macro &v);
+void load(QDataStream &s, Macro &v);
+void save(QDataStream &s, const CMakeConfigItem &v);
+void load(QDataStream &s, CMakeConfigItem &v);
+void save(QDataStream &s, const cmListFileArgument &v);
+void load(QDataStream &s, cmListFileArgument &v);
+void save(QDataStream &s, const cmListFile &v);
+void load(QDataStream &s, cmListFile &v);
+void save(QDataStream &s, const CMakeFileInfo &v);
+void load(QDataStream &s, CMakeFileInfo &v);
+void save(QDataStream &s, const Backtrace &v);
+void load(QDataStream &s, Backtrace &v);
+void save(QDataStream &s, const CMakeBuildTarget &v);
+void load(QDataStream &s, CMakeBuildTarget &v);
+void save(QDataStream &s, const RawProjectPart &v);
+void load(QDataStream &s, RawProjectPart &v);
+
+bool readSize(QDataStream &s, int &size)
+{
+    qint32 count = -1;
+    s >> count;
+    if (count < 0 || s.status() != QDataStream::Ok) {
+        s.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+    size = count;
+    return true;
+}
+
+template<typename T>
+void save(QDataStream &s, const std::vector<T> &v)
+{
+    s << qint32(v.size());
+    for (const T &e : v)
+        save(s, e);
+}
+
+template<typename T>
+void load(QDataStream &s, std::vector<T> &v)
+{
+    int size = 0;
+    if (!readSize(s, size))
+        return;
+    v.clear();
+    for (int i = 0; i < size && s.status() == QDataStream::Ok; ++i) {
+        T e;
+        load(s, e);
+        v.push_back(std::move(e));
+    }
+}
+
+template<typename T>
+void save(QDataStream &s, const QList<T> &v)
+{
+    s << qint32(v.size());
+    for (const T &e : v)
+        save(s, e);
+}
+
+template<typename T>
+void load(QDataStream &s, QList<T> &v)
+{
+    int size = 0;
+    if (!readSize(s, size))
+        return;
+    v.clear();
+    for (int i = 0; i < size && s.status() == QDataStream::Ok; ++i) {
+        T e;
+        load(s, e);
+        v.append(std::move(e));
+    }
+}
+
+template<typename T>
+void save(QDataStream &s, const std::optional<T> &v)
+{
+    s << v.has_value();
+    if (v)
+        save(s, *v);
+}
+
+template<typename T>
+void load(QDataStream &s, std::optional<T> &v)
+{
+    bool hasValue = false;
+    s >> hasValue;
+    v.reset();
+    if (hasValue) {
+        T e;
+        load(s, e);
+        v = std::move(e);
+    }
+}
+
+// Codemodel:
+
+void save(QDataStream &s, const Directory &v)
+{
+    save(s, v.buildPath);
+    save(s, v.sourcePath);
+    save(s, v.parent);
+    save(s, v.project);
+    save(s, v.children);
+    save(s, v.targets);
+    save(s, v.hasInstallRule);
+}
+
+void load(QDataStream &s, Directory &v)
+{
+    load(s, v.buildPath);
+    load(s, v.sourcePath);
+    load(s, v.parent);
+    load(s, v.project);
+    load(s, v.children);
+    load(s, v.targets);
+    load(s, v.hasInstallRule);
+}
+
+void save(QDataStream &s, const Project &v)
+{
+    save(s, v.name);
+    save(s, v.parent);
+    save(s, v.children);
+    save(s, v.directories);
+    save(s, v.targets);
+}
+
+void load(QDataStream &s, Project &v)
+{
+    load(s, v.name);
+    load(s, v.parent);
+    load(s, v.children);
+    load(s, v.directories);
+    load(s, v.targets);
+}
+
+void save(QDataStream &s, const Target &v)
+{
+    save(s, v.name);
+    save(s, v.id);
+    save(s, v.directory);
+    save(s, v.project);
+    save(s, v.jsonFile);
+}
+
+void load(QDataStream &s, Target &v)
+{
+    load(s, v.name);
+    load(s, v.id);
+    load(s, v.directory);
+    load(s, v.project);
+    load(s, v.jsonFile);
+}
+
+void save(QDataStream &s, const Configuration &v)
+{
+    save(s, v.name);
+    save(s, v.directories);
+    save(s, v.projects);
+    save(s, v.targets);
+}
+
+void load(QDataStream &s, Configuration &v)
+{
+    load(s, v.name);
+    load(s, v.directories);
+    load(s, v.projects);
+    load(s, v.targets);
+}
+
+// Target details:
+
+void save(QDataStream &s, const InstallDestination &v)
+{
+    save(s, v.path);
+    save(s, v.backtrace);
+}
+
+void load(QDataStream &s, InstallDestination &v)
+{
+    load(s, v.path);
+    load(s, v.backtrace);
+}
+
+void save(QDataStream &s, const FragmentInfo &v)
+{
+    save(s, v.fragment);
+    save(s, v.role);
+}
+
+void load(QDataStream &s, FragmentInfo &v)
+{
+    load(s, v.fragment);
+    load(s, v.role);
+}
+
+void save(QDataStream &s, const LinkInfo &v)
+{
+    save(s, v.language);
+    save(s, v.fragments);
+    save(s, v.isLto);
+    save(s, v.sysroot);
+}
+
+void load(QDataStream &s, LinkInfo &v)
+{
+    load(s, v.language);
+    load(s, v.fragments);
+    load(s, v.isLto);
+    load(s, v.sysroot);
+}
+
+void save(QDataStream &s, const ArchiveInfo &v)
+{
+    save(s, v.fragments);
+    save(s, v.isLto);
+}
+
+void load(QDataStream &s, ArchiveInfo &v)
+{
+    load(s, v.fragments);
+    load(s, v.isLto);
+}
+
+void save(QDataStream &s, const DependencyInfo &v)
+{
+    save(s, v.targetId);
+    save(s, v.backtrace);
+}
+
+void load(QDataStream &s, DependencyInfo &v)
+{
+    load(s, v.targetId);
+    load(s, v.backtrace);
+}
+
+void save(QDataStream &s, const SourceInfo &v)
+{
+    save(s, v.path);
+    save(s, v.compileGroup);
+    save(s, v.sourceGroup);
+    save(s, v.backtrace);
+    save(s, v.isGenerated);
+}
+
+void load(QDataStream &s, SourceInfo &v)
+{
+    load(s, v.path);
+    load(s, v.compileGroup);
+    load(s, v.sourceGroup);
+    load(s, v.backtrace);
+    load(s, v.isGenerated);
+}
+
+void save(QDataStream &s, const IncludeInfo &v)
+{
+    save(s, v.path);
+    save(s, v.backtrace);
+}
+
+void load(QDataStream &s, IncludeInfo &v)
+{
+    load(s, v.path);
+    load(s, v.backtrace);
+}
+
+void save(QDataStream &s, const DefineInfo &v)
+{
+    save(s, v.define);
+    save(s, v.backtrace);
+}
+
+void load(QDataStream &s, DefineInfo &v)
+{
+    load(s, v.define);
+    load(s, v.backtrace);
+}
+
+void save(QDataStream &s, const CompileInfo &v)
+{
+    save(s, v.sources);
+    save(s, v.language);
+    save(s, v.fragments);
+    save(s, v.includes);
+    save(s, v.defines);
+    save(s, v.sysroot);
+}
+
+void load(QDataStream &s, CompileInfo &v)
+{
+    load(s, v.sources);
+    load(s, v.language);
+    load(s, v.fragments);
+    load(s, v.includes);
+    load(s, v.defines);
+    load(s, v.sysroot);
+}
+
+void save(QDataStream &s, const BacktraceNode &v)
+{
+    save(s, v.file);
+    save(s, v.line);
+    save(s, v.command);
+    save(s, v.parent);
+}
+
+void load(QDataStream &s, BacktraceNode &v)
+{
+    load(s, v.file);
+    load(s, v.line);
+    load(s, v.command);
+    load(s, v.parent);
+}
+
+void save(QDataStream &s, const TargetDetails &v)
+{
+    save(s, v.name);
+    save(s, v.id);
+    save(s, v.type);
+    save(s, v.folderTargetProperty);
+    save(s, v.sourceDir);
+    save(s, v.buildDir);
+    save(s, v.backtrace);
+    save(s, v.isGeneratorProvided);
+    save(s, v.nameOnDisk);
+    save(s, v.artifacts);
+    save(s, v.installPrefix);
+    save(s, v.installDestination);
+    save(s, v.link);
+    save(s, v.archive);
+    save(s, v.dependencies);
+    save(s, v.sources);
+    save(s, v.sourceGroups);
+    save(s, v.compileGroups);
+    save(s, v.backtraceGraph.commands);
+    save(s, v.backtraceGraph.files);
+    save(s, v.backtraceGraph.nodes);
+}
+
+void load(QDataStream &s, TargetDetails &v)
+{
+    load(s, v.name);
+    load(s, v.id);
+    load(s, v.type);
+    load(s, v.folderTargetProperty);
+    load(s, v.sourceDir);
+    load(s, v.buildDir);
+    load(s, v.backtrace);
+    load(s, v.isGeneratorProvided);
+    load(s, v.nameOnDisk);
+    load(s, v.artifacts);
+    load(s, v.installPrefix);
+    load(s, v.installDestination);
+    load(s, v.link);
+    load(s, v.archive);
+    load(s, v.dependencies);
+    load(s, v.sources);
+    load(s, v.sourceGroups);
+    load(s, v.compileGroups);
+    load(s, v.backtraceGraph.commands);
+    load(s, v.backtraceGraph.files);
+    load(s, v.backtraceGraph.nodes);
+}
+
+// Code model:
+
+void save(QDataStream &s, const HeaderPath &v)
+{
+    save(s, v.path);
+    save(s, int(v.type));
+}
+
+void load(QDataStream &s, HeaderPath &v)
+{
+    int type = 0;
+    load(s, v.path);
+    load(s, type);
+    v.type = HeaderPathType(type);
+}
+
+void save(QDataStream &s, const Macro &v)
+{
+    save(s, v.key);
+    save(s, v.value);
+    save(s, int(v.type));
+}
+
+void load(QDataStream &s, Macro &v)
+{
+    int type = 0;
+    load(s, v.key);
+    load(s, v.value);
+    load(s, type);
+    v.type = MacroType(type);
+}
+
+void save(QDataStream &s, const RawProjectPart &v)
+{
+    save(s, v.displayName);
+    save(s, v.projectFile);
+    save(s, v.projectFileLine);
+    save(s, v.projectFileColumn);
+    save(s, v.buildSystemTarget);
+    save(s, int(v.buildTargetType));
+    save(s, v.files);
+    // The mime type callback cannot be stored, store its results instead:
+    save(s, Utils::transform(v.files, [&v](const QString &file) {
+             return v.getMimeType ? v.getMimeType(file) : QString();
+         }));
+    save(s, v.precompiledHeaders);
+    save(s, v.headerPaths);
+    save(s, v.projectMacros);
+    save(s, v.flagsForC.commandLineFlags);
+    save(s, v.flagsForCxx.commandLineFlags);
+}
+
+void load(QDataStream &s, RawProjectPart &v)
+{
+    QString displayName;
+    QString projectFile;
+    int projectFileLine = -1;
+    int projectFileColumn = -1;
+    QString buildSystemTarget;
+    int buildTargetType = 0;
+    QStringList files;
+    QStringList mimeTypes;
+    QStringList precompiledHeaders;
+    HeaderPaths headerPaths;
+    Macros macros;
+    RawProjectPartFlags flagsForC;
+    RawProjectPartFlags flagsForCxx;
+
+    load(s, displayName);
+    load(s, projectFile);
+    load(s, projectFileLine);
+    load(s, projectFileColumn);
+    load(s, buildSystemTarget);
+    load(s, buildTargetType);
+    load(s, files);
+    load(s, mimeTypes);
+    load(s, precompiledHeaders);
+    load(s, headerPaths);
+    load(s, macros);
+    load(s, flagsForC.commandLineFlags);
+    load(s, flagsForCxx.commandLineFlags);
+    if (s.status() != QDataStream::Ok || mimeTypes.size() != files.size())
+        return;
+
+    QHash<QString, QString> mimeTypeForFile;
+    mimeTypeForFile.reserve(files.size());
+    for (int i = 0; i < files.size(); ++i)
+        mimeTypeForFile.insert(files.at(i), mimeTypes.at(i));
+
+    v.setDisplayName(displayName);
+    v.setProjectFileLocation(projectFile, projectFileLine, projectFileColumn);
+    v.setBuildSystemTarget(buildSystemTarget);
+    v.setBuildTargetType(BuildTargetType(buildTargetType));
+    v.setMacros(macros);
+    v.setHeaderPaths(headerPaths);
+    v.setFiles(files, {}, [mimeTypeForFile](const QString &path) {
+        return mimeTypeForFile.value(path);
+    });
+    if (!precompiledHeaders.isEmpty())
+        v.setPreCompiledHeaders(precompiledHeaders);
+    if (!flagsForC.commandLineFlags.isEmpty())
+        v.setFlagsForC(flagsForC);
+    if (!flagsForCxx.commandLineFlags.isEmpty())
+        v.setFlagsForCxx(flagsForCxx);
+}
+
+// Cache and CMake files:
+
+void save(QDataStream &s, const CMakeConfigItem &v)
+{
+    save(s, v.key);
+    save(s, int(v.type));
+    save(s, v.isAdvanced);
+    save(s, v.inCMakeCache);
+    save(s, v.isUnset);
+    save(s, v.isInitial);
+    save(s, v.value);
+    save(s, v.documentation);
+    save(s, v.values);
+}
+
+void load(QDataStream &s, CMakeConfigItem &v)
+{
+    int type = 0;
+    load(s, v.key);
+    load(s, type);
+    load(s, v.isAdvanced);
+    load(s, v.inCMakeCache);
+    load(s, v.isUnset);
+    load(s, v.isInitial);
+    load(s, v.value);
+    load(s, v.documentation);
+    load(s, v.values);
+    v.type = CMakeConfigItem::Type(type);
+}
+
+void save(QDataStream &s, const cmListFileArgument &v)
+{
+    save(s, v.Value);
+    save(s, int(v.Delim));
+    save(s, v.Line);
+    save(s, v.Column);
+}
+
+void load(QDataStream &s, cmListFileArgument &v)
+{
+    int delim = 0;
+    load(s, v.Value);
+    load(s, delim);
+    load(s, v.Line);
+    load(s, v.Column);
+    v.Delim = cmListFileArgument::Delimiter(delim);
+}
+
+void save(QDataStream &s, const cmListFile &v)
+{
+    s << qint32(v.Functions.size());
+    for (const cmListFileFunction &f : v.Functions) {
+        save(s, f.OriginalName());
+        save(s, f.Line());
+        save(s, f.LineEnd());
+        save(s, f.Arguments());
+    }
+}
+
+void load(QDataStream &s, cmListFile &v)
+{
+    int size = 0;
+    if (!readSize(s, size))
+        return;
+    v.Functions.clear();
+    for (int i = 0; i < size && s.status() == QDataStream::Ok; ++i) {
+        std::string name;
+        long line = 0;
+        long lineEnd = 0;
+        std::vector<cmListFileArgument> arguments;
+        load(s, name);
+        load(s, line);
+        load(s, lineEnd);
+        load(s, arguments);
+        v.Functions.emplace_back(std::move(name), line, lineEnd, std::move(arguments));
+    }
+}
+
+void save(QDataStream &s, const CMakeFileInfo &v)
+{
+    save(s, v.path);
+    save(s, v.isCMake);
+    save(s, v.isCMakeListsDotTxt);
+    save(s, v.isExternal);
+    save(s, v.isGenerated);
+    save(s, v.cmakeListFile);
+    // Used to find the files that changed after the snapshot was written
+    s << (v.lastModified.isValid() ? v.lastModified.toMSecsSinceEpoch() : qint64(-1));
+    s << qint64(v.size);
+}
+
+void load(QDataStream &s, CMakeFileInfo &v)
+{
+    load(s, v.path);
+    load(s, v.isCMake);
+    load(s, v.isCMakeListsDotTxt);
+    load(s, v.isExternal);
+    load(s, v.isGenerated);
+    load(s, v.cmakeListFile);
+    qint64 lastModified = -1;
+    qint64 size = -1;
+    s >> lastModified >> size;
+    v.lastModified = lastModified >= 0 ? QDateTime::fromMSecsSinceEpoch(lastModified)
+                                       : QDateTime();
+    v.size = size;
+}
+
+// Build targets:
+
+void save(QDataStream &s, const Backtrace &v)
+{
+    s << qint32(v.size());
+    for (const FolderNode::LocationInfo &i : v) {
+        save(s, i.displayName);
+        save(s, i.path);
+        save(s, i.line);
+        s << quint32(i.priority);
+    }
+}
+
+void load(QDataStream &s, Backtrace &v)
+{
+    int size = 0;
+    if (!readSize(s, size))
+        return;
+    v.clear();
+    for (int i = 0; i < size && s.status() == QDataStream::Ok; ++i) {
+        QString displayName;
+        FilePath path;
+        int line = 0;
+        quint32 priority = 0;
+        load(s, displayName);
+        load(s, path);
+        load(s, line);
+        s >> priority;
+        v.append(FolderNode::LocationInfo(displayName, path, line, priority));
+    }
+}
+
+void save(QDataStream &s, const CMakeBuildTarget &v)
+{
+    save(s, v.title);
+    save(s, v.executable);
+    save(s, int(v.targetType));
+    save(s, v.linksToQtGui);
+    save(s, v.qtcRunnable);
+    save(s, v.workingDirectory);
+    save(s, v.sourceDirectory);
+    save(s, v.makeCommand);
+    save(s, v.libraryDirectories);
+    save(s, v.backtrace);
+    save(s, v.dependencyDefinitions);
+    save(s, v.sourceDefinitions);
+    save(s, v.defineDefinitions);
+    save(s, v.includeDefinitions);
+    save(s, v.installDefinitions);
+    save(s, v.includeFiles);
+    save(s, v.compilerOptions);
+    save(s, v.macros);
+    save(s, v.files);
+}
+
+void load(QDataStream &s, CMakeBuildTarget &v)
+{
+    int targetType = 0;
+    load(s, v.title);
+    load(s, v.executable);
+    load(s, targetType);
+    load(s, v.linksToQtGui);
+    load(s, v.qtcRunnable);
+    load(s, v.workingDirectory);
+    load(s, v.sourceDirectory);
+    load(s, v.makeCommand);
+    load(s, v.libraryDirectories);
+    load(s, v.backtrace);
+    load(s, v.dependencyDefinitions);
+    load(s, v.sourceDefinitions);
+    load(s, v.defineDefinitions);
+    load(s, v.includeDefinitions);
+    load(s, v.installDefinitions);
+    load(s, v.includeFiles);
+    load(s, v.compilerOptions);
+    load(s, v.macros);
+    load(s, v.files);
+    v.targetType = TargetType(targetType);
+}
+
+void saveKey(QDataStream &s, const FileApiSnapshot::Key &key)
+{
+    s << SNAPSHOT_MAGIC << SNAPSHOT_VERSION;
+    save(s, key.replyFileName);
+    s << key.replyTimestamp.toMSecsSinceEpoch();
+    save(s, key.sourceDirectory);
+    save(s, key.buildDirectory);
+    save(s, key.cmakeBuildType);
+    save(s, key.isPlain);
+}
+
+bool checkKey(QDataStream &s, const FileApiSnapshot::Key &key)
+{
+    quint32 magic = 0;
+    quint32 version = 0;
+    s >> magic >> version;
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+        return false;
+
+    FileApiSnapshot::Key stored;
+    qint64 timestamp = 0;
+    load(s, stored.replyFileName);
+    s >> timestamp;
+    load(s, stored.sourceDirectory);
+    load(s, stored.buildDirectory);
+    load(s, stored.cmakeBuildType);
+    load(s, stored.isPlain);
+
+    return s.status() == QDataStream::Ok && stored.replyFileName == key.replyFileName
+           && timestamp == key.replyTimestamp.toMSecsSinceEpoch()
+           && stored.sourceDirectory == key.sourceDirectory
+           && stored.buildDirectory == key.buildDirectory
+           && stored.cmakeBuildType == key.cmakeBuildType && stored.isPlain == key.isPlain;
+}
+
+} // namespace
+
+// --------------------------------------------------------------------
+// FileApiSnapshot:
+// --------------------------------------------------------------------
+
+FilePath FileApiSnapshot::snapshotFile(const FilePath &buildDirectory)
+{
+    return buildDirectory.pathAppended(SNAPSHOT_RELATIVE_PATH);
+}
+
+bool FileApiSnapshot::isSupported(const FilePath &buildDirectory)
+{
+    // The snapshot is memory mapped, so it needs to be a local file:
+    return !buildDirectory.isEmpty() && !buildDirectory.needsDevice();
+}
+
+bool FileApiSnapshot::write(const Key &key, const FileApiQtcData &result)
+{
+    QTC_ASSERT(isSupported(key.buildDirectory), return false);
+    QTC_ASSERT(result.codemodel && result.targetCache, return false);
+    QTC_ASSERT(result.buildTargets.size() == result.targetFiles.size(), return false);
+
+    std::vector<std::shared_ptr<const CachedTarget>> targets;
+    targets.reserve(result.targetFiles.size());
+    QSet<QString> targetsWithCachedParts;
+    for (const QString &targetFile : result.targetFiles) {
+        std::shared_ptr<const CachedTarget> cached = result.targetCache->targets.value(targetFile);
+        QTC_ASSERT(cached, return false);
+        if (cached->projectParts)
+            targetsWithCachedParts.insert(cached->details->name);
+        targets.push_back(std::move(cached));
+    }
+
+    const FilePath file = snapshotFile(key.buildDirectory);
+    if (!file.parentDir().ensureWritableDir())
+        return false;
+
+    QByteArray contents;
+    {
+        QDataStream s(&contents, QIODevice::WriteOnly);
+        s.setVersion(QDataStream::Qt_6_0);
+
+        saveKey(s, key);
+        save(s, *result.codemodel);
+        save(s, result.targetFiles);
+        save(s, result.targetCache->relativeLibs);
+        for (const std::shared_ptr<const CachedTarget> &cached : targets) {
+            save(s, *cached->details);
+            save(s, cached->projectParts);
+        }
+        save(s, result.buildTargets);
+        // The project parts of the other targets were stored with the target cache already:
+        save(s, Utils::filtered(result.projectParts, [&](const RawProjectPart &rpp) {
+                 return !targetsWithCachedParts.contains(rpp.buildSystemTarget);
+             }));
+
+        save(s, result.cache);
+
+        QList<CMakeFileInfo> cmakeFiles = Utils::toList(result.cmakeFiles);
+        Utils::sort(cmakeFiles);
+        save(s, cmakeFiles);
+
+        save(s, result.ctestPath);
+        save(s, result.isMultiConfig);
+        save(s, result.usesAllCapsTargets);
+        s << SNAPSHOT_END_MARKER;
+    }
+
+    QSaveFile saveFile(file.toFSPathString());
+    if (!saveFile.open(QIODevice::WriteOnly) || saveFile.write(contents) != contents.size()
+        || !saveFile.commit()) {
+        qCWarning(cmakeSnapshot) << "Failed to write snapshot" << file;
+        return false;
+    }
+    qCDebug(cmakeSnapshot) << "Wrote snapshot" << file << contents.size() << "bytes";
+    return true;
+}
+
+void FileApiSnapshot::writeInBackground(const Key &key, const FileApiQtcData &result)
+{
+    // Copies of the implicitly shared values, so the result can be consumed meanwhile:
+    auto contents = std::make_shared<FileApiQtcData>();
+    contents->cache = result.cache;
+    contents->cmakeFiles = result.cmakeFiles;
+    contents->buildTargets = result.buildTargets;
+    contents->projectParts = result.projectParts;
+    contents->ctestPath = result.ctestPath;
+    contents->isMultiConfig = result.isMultiConfig;
+    contents->usesAllCapsTargets = result.usesAllCapsTargets;
+    contents->codemodel = result.codemodel;
+    contents->targetFiles = result.targetFiles;
+    contents->targetCache = result.targetCache;
+
+    const QFuture<void> future = Utils::asyncRun(ProjectExplorerPlugin::sharedThreadPool(),
+                                                 [key, contents] { write(key, *contents); });
+    ExtensionSystem::PluginManager::futureSynchronizer()->addFuture(future);
+}
+
+bool FileApiSnapshot::read(const Key &key, FileApiData &data, FileApiQtcData &result)
+{
+    if (!isSupported(key.buildDirectory))
+        return false;
+
+    QFile file(snapshotFile(key.buildDirectory).toFSPathString());
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = file.size();
+    const uchar *mapped = size > 0 ? file.map(0, size) : nullptr;
+    if (!mapped)
+        return false;
+
+    const QByteArray contents = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped),
+                                                        size);
+    QDataStream s(contents);
+    s.setVersion(QDataStream::Qt_6_0);
+
+    if (!checkKey(s, key)) {
+        qCDebug(cmakeSnapshot) << "Outdated snapshot" << file.fileName();
+        return false;
+    }
+
+    FileApiData restoredData;
+    FileApiQtcData restored;
+    QStringList targetFiles;
+    bool relativeLibs = false;
+    load(s, restoredData.codemodel);
+    load(s, targetFiles);
+    load(s, relativeLibs);
+    std::vector<std::optional<RawProjectParts>> cachedParts;
+    for (int i = 0; i < targetFiles.size() && s.status() == QDataStream::Ok; ++i) {
+        TargetDetails details;
+        std::optional<RawProjectParts> projectParts;
+        load(s, details);
+        load(s, projectParts);
+        restoredData.targetDetails.push_back(std::move(details));
+        cachedParts.push_back(std::move(projectParts));
+    }
+    load(s, restored.buildTargets);
+    RawProjectParts otherParts;
+    load(s, otherParts);
+
+    load(s, restored.cache);
+
+    QList<CMakeFileInfo> cmakeFiles;
+    load(s, cmakeFiles);
+    restored.cmakeFiles = Utils::toSet(cmakeFiles);
+
+    load(s, restored.ctestPath);
+    load(s, restored.isMultiConfig);
+    load(s, restored.usesAllCapsTargets);
+
+    quint32 endMarker = 0;
+    s >> endMarker;
+    if (s.status() != QDataStream::Ok || endMarker != SNAPSHOT_END_MARKER
+        || restored.buildTargets.size() != targetFiles.size()) {
+        qCWarning(cmakeSnapshot) << "Broken snapshot" << file.fileName();
+        return false;
+    }
+
+    // Share the storage of equal values again, like a regular parse does:
+    FileApiStringPool stringPool;
+    for (std::optional<RawProjectParts> &rpps : cachedParts) {
+        if (rpps) {
+            for (RawProjectPart &rpp : *rpps)
+                stringPool.internProjectPart(rpp);
+        }
+    }
+    QHash<QString, RawProjectParts> otherPartsOfTarget;
+    for (RawProjectPart &rpp : otherParts) {
+        stringPool.internProjectPart(rpp);
+        otherPartsOfTarget[rpp.buildSystemTarget].append(rpp);
+    }
+
+    // Restore the target cache as well, the next parse only extracts the changed targets:
+    auto targetCache = std::make_shared<FileApiTargetCache>();
+    targetCache->relativeLibs = relativeLibs;
+    targetCache->targets.reserve(targetFiles.size());
+    for (int i = 0; i < targetFiles.size(); ++i) {
+        auto cached = std::make_shared<CachedTarget>();
+        cached->details = std::make_shared<const TargetDetails>(
+            restoredData.targetDetails[size_t(i)]);
+        cached->buildTarget = restored.buildTargets.at(i);
+        cached->projectParts = std::move(cachedParts[size_t(i)]);
+        restored.projectParts.append(cached->projectParts
+                                         ? *cached->projectParts
+                                         : otherPartsOfTarget.value(cached->details->name));
+        targetCache->targets.insert(targetFiles.at(i), std::move(cached));
+    }
+    restored.targetFiles = std::move(targetFiles);
+    restored.targetCache = std::move(targetCache);
+    restored.isRestored = true;
+
+    data = std::move(restoredData);
+    result = std::move(restored);
+    qCDebug(cmakeSnapshot) << "Read snapshot" << file.fileName() << size << "bytes";
+    return true;
+}
+
+} // CMakeProjectManager::Internal
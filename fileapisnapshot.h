@@ -0,0 +1,48 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QDateTime>
+#include <QString>
+
+namespace CMakeProjectManager::Internal {
+
+class FileApiData;
+class FileApiQtcData;
+
+// Binary snapshot of the extracted file-api data, stored in the build directory.
+//
+// The snapshot holds everything the project needs after a parse, except for the project
+// tree: Nodes are recreated from the stored codemodel and target details, which avoids
+// reading and parsing the reply and CMake files when a project is opened again. The target
+// details are stored with the target cache, which is restored as well.
+class FileApiSnapshot
+{
+public:
+    class Key
+    {
+    public:
+        QString replyFileName;
+        QDateTime replyTimestamp;
+        Utils::FilePath sourceDirectory;
+        Utils::FilePath buildDirectory;
+        QString cmakeBuildType;
+        bool isPlain = false;
+    };
+
+    static Utils::FilePath snapshotFile(const Utils::FilePath &buildDirectory);
+    static bool isSupported(const Utils::FilePath &buildDirectory);
+
+    // Needs the codemodel and target cache of the result of extractData()
+    static bool write(const Key &key, const FileApiQtcData &result);
+    // Shares the data of the result, which can be consumed right after. Call from the main
+    // thread.
+    static void writeInBackground(const Key &key, const FileApiQtcData &result);
+
+    static bool read(const Key &key, FileApiData &data, FileApiQtcData &result);
+};
+
+} // CMakeProjectManager::Internal
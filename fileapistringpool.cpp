@@ -0,0 +1,102 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "fileapistringpool.h"
+
+#include <projectexplorer/rawprojectpart.h>
+
+using namespace ProjectExplorer;
+
+namespace CMakeProjectManager::Internal {
+
+// --------------------------------------------------------------------
+// Helper:
+// --------------------------------------------------------------------
+
+template<typename Value>
+static Value internValue(QSet<Value> &pool, const Value &value)
+{
+    if (value.isEmpty())
+        return value;
+    const auto it = pool.constFind(value);
+    if (it != pool.constEnd())
+        return *it;
+    pool.insert(value);
+    return value;
+}
+
+template<typename List, typename HashFunction>
+static List internList(QMultiHash<size_t, List> &pool, const List &list, const HashFunction &hash)
+{
+    if (list.isEmpty())
+        return list;
+
+    size_t seed = 0;
+    for (const auto &element : list)
+        seed = qHashMulti(seed, hash(element));
+
+    for (auto it = pool.constFind(seed); it != pool.constEnd() && it.key() == seed; ++it) {
+        if (*it == list)
+            return *it;
+    }
+    pool.insert(seed, list);
+    return list;
+}
+
+// --------------------------------------------------------------------
+// FileApiStringPool:
+// --------------------------------------------------------------------
+
+QString FileApiStringPool::string(const QString &value)
+{
+    return internValue(m_strings, value);
+}
+
+QByteArray FileApiStringPool::bytes(const QByteArray &value)
+{
+    return internValue(m_bytes, value);
+}
+
+QStringList FileApiStringPool::stringList(const QStringList &list)
+{
+    QStringList interned;
+    interned.reserve(list.size());
+    for (const QString &s : list)
+        interned.append(string(s));
+
+    return internList(m_stringLists, interned, [](const QString &s) { return qHash(s); });
+}
+
+HeaderPaths FileApiStringPool::headerPaths(const HeaderPaths &list)
+{
+    HeaderPaths interned;
+    interned.reserve(list.size());
+    for (const HeaderPath &hp : list)
+        interned.append(HeaderPath(string(hp.path), hp.type));
+
+    return internList(m_headerPaths, interned, [](const HeaderPath &hp) {
+        return qHashMulti(0, hp.path, int(hp.type));
+    });
+}
+
+Macros FileApiStringPool::macros(const Macros &list)
+{
+    Macros interned;
+    interned.reserve(list.size());
+    for (const Macro &m : list)
+        interned.append(Macro(bytes(m.key), bytes(m.value), m.type));
+
+    return internList(m_macros, interned, [](const Macro &m) {
+        return qHashMulti(0, m.key, m.value, int(m.type));
+    });
+}
+
+void FileApiStringPool::internProjectPart(RawProjectPart &rpp)
+{
+    rpp.setHeaderPaths(headerPaths(rpp.headerPaths));
+    rpp.setMacros(macros(rpp.projectMacros));
+    rpp.flagsForC.commandLineFlags = stringList(rpp.flagsForC.commandLineFlags);
+    rpp.flagsForCxx.commandLineFlags = stringList(rpp.flagsForCxx.commandLineFlags);
+}
+
+} // CMakeProjectManager::Internal
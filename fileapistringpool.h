@@ -0,0 +1,47 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <projectexplorer/headerpath.h>
+#include <projectexplorer/projectmacro.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+namespace ProjectExplorer { class RawProjectPart; }
+
+namespace CMakeProjectManager::Internal {
+
+// Deduplicates the values of the file-api reply.
+//
+// Big projects repeat the same include paths, defines and compiler flags for hundreds of
+// targets. The pool hands out one implicitly shared instance per distinct value, for single
+// strings as well as for whole lists, so memory use grows with the number of unique values.
+// Not thread-safe.
+class FileApiStringPool
+{
+public:
+    QString string(const QString &value);
+    QByteArray bytes(const QByteArray &value);
+
+    QStringList stringList(const QStringList &list);
+    ProjectExplorer::HeaderPaths headerPaths(const ProjectExplorer::HeaderPaths &list);
+    ProjectExplorer::Macros macros(const ProjectExplorer::Macros &list);
+
+    // Interns the header paths, macros and flags of the part
+    void internProjectPart(ProjectExplorer::RawProjectPart &rpp);
+
+private:
+    QSet<QString> m_strings;
+    QSet<QByteArray> m_bytes;
+
+    QMultiHash<size_t, QStringList> m_stringLists;
+    QMultiHash<size_t, ProjectExplorer::HeaderPaths> m_headerPaths;
+    QMultiHash<size_t, ProjectExplorer::Macros> m_macros;
+};
+
+} // CMakeProjectManager::Internal
@@ -8,11 +8,19 @@
 
 #include <projectexplorer/projectexplorerconstants.h>
 #include <projectexplorer/projectmanager.h>
+#include <projectexplorer/projecttree.h>
 
 #include <utils/algorithm.h>
 #include <utils/fsengine/fileiconprovider.h>
 #include <utils/qtcassert.h>
 
+#include <QMultiHash>
+#include <QSet>
+
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
 using namespace ProjectExplorer;
 
 namespace CMakeProjectManager::Internal {
@@ -147,14 +155,15 @@ QHash<Utils::FilePath, ProjectNode *> addCMakeLists(
 
 void createProjectNode(const QHash<Utils::FilePath, ProjectNode *> &cmakeListsNodes,
                        const Utils::FilePath &dir,
-                       const QString &displayName)
+                       const QString &displayName,
+                       TreeNodeIndex &index)
 {
     ProjectNode *cmln = cmakeListsNodes.value(dir);
     QTC_ASSERT(cmln, return );
 
     const Utils::FilePath projectName = dir.pathAppended(".project::" + displayName);
 
-    ProjectNode *pn = cmln->projectNode(projectName);
+    ProjectNode *&pn = index.projectNodes[projectName];
     if (!pn) {
         auto newNode = std::make_unique<CMakeProjectNode>(projectName);
         pn = newNode.get();
@@ -165,15 +174,13 @@ void createProjectNode(const QHash<Utils::FilePath, ProjectNode *> &cmakeListsNo
 
 CMakeTargetNode *createTargetNode(const QHash<Utils::FilePath, ProjectNode *> &cmakeListsNodes,
                                   const Utils::FilePath &dir,
-                                  const QString &displayName)
+                                  const QString &displayName,
+                                  TreeNodeIndex &index)
 {
     ProjectNode *cmln = cmakeListsNodes.value(dir);
     QTC_ASSERT(cmln, return nullptr);
 
-    QString targetId = displayName;
-
-    CMakeTargetNode *tn = static_cast<CMakeTargetNode *>(
-        cmln->findNode([&targetId](const Node *n) { return n->buildKey() == targetId; }));
+    CMakeTargetNode *&tn = index.targetNodes[{dir, displayName}];
     if (!tn) {
         auto newNode = std::make_unique<CMakeTargetNode>(dir, displayName);
         tn = newNode.get();
@@ -220,4 +227,120 @@ void addFileSystemNodes(ProjectNode *root, const std::shared_ptr<FolderNode> &fo
     }
 }
 
+// True if the nodes stand for the same thing, the children of folders are not compared
+static bool isSameNode(const Node *a, const Node *b)
+{
+    if (typeid(*a) != typeid(*b) || a->filePath() != b->filePath()
+        || a->displayName() != b->displayName() || a->priority() != b->priority()
+        || a->isGenerated() != b->isGenerated() || a->isEnabled() != b->isEnabled()
+        || a->listInProject() != b->listInProject() || a->buildKey() != b->buildKey()) {
+        return false;
+    }
+    if (const FileNode *fileNode = a->asFileNode())
+        return fileNode->fileType() == b->asFileNode()->fileType();
+    return true;
+}
+
+static void mergeFolderNode(FolderNode *target,
+                            FolderNode *source,
+                            QList<FolderNode *> &changedFolders,
+                            QList<FolderNode *> &extendedFolders,
+                            std::vector<std::unique_ptr<Node>> &removedNodes)
+{
+    target->setLocationInfo(source->locationInfo());
+    if (auto targetNode = dynamic_cast<CMakeTargetNode *>(target)) {
+        if (targetNode->copyTargetInformation(*static_cast<const CMakeTargetNode *>(source)))
+            changedFolders.append(target);
+    }
+
+    QMultiHash<Utils::FilePath, Node *> sourceNodes;
+    for (Node *node : source->nodes())
+        sourceNodes.insert(node->filePath(), node);
+
+    bool childrenChanged = false;
+    for (Node *targetNode : target->nodes()) {
+        Node *sourceNode = nullptr;
+        for (auto it = sourceNodes.find(targetNode->filePath());
+             it != sourceNodes.end() && it.key() == targetNode->filePath();
+             ++it) {
+            if (isSameNode(targetNode, *it)) {
+                sourceNode = *it;
+                sourceNodes.erase(it);
+                break;
+            }
+        }
+        if (!sourceNode) {
+            removedNodes.push_back(target->takeNode(targetNode));
+            childrenChanged = true;
+        } else if (FolderNode *targetFolder = targetNode->asFolderNode()) {
+            mergeFolderNode(targetFolder,
+                            sourceNode->asFolderNode(),
+                            changedFolders,
+                            extendedFolders,
+                            removedNodes);
+        }
+    }
+
+    // The new nodes, in the order of the source
+    bool extended = false;
+    for (Node *sourceNode : source->nodes()) {
+        if (sourceNodes.contains(sourceNode->filePath(), sourceNode)) {
+            target->addNode(source->takeNode(sourceNode));
+            extended = true;
+        }
+    }
+    if (extended) {
+        extendedFolders.append(target);
+        childrenChanged = true;
+    }
+
+    if (childrenChanged)
+        changedFolders.append(target);
+}
+
+static FolderNode *commonAncestor(FolderNode *a, FolderNode *b)
+{
+    QSet<FolderNode *> ancestorsOfA;
+    for (FolderNode *folder = a; folder; folder = folder->parentFolderNode())
+        ancestorsOfA.insert(folder);
+    for (FolderNode *folder = b; folder; folder = folder->parentFolderNode()) {
+        if (ancestorsOfA.contains(folder))
+            return folder;
+    }
+    return nullptr;
+}
+
+bool mergeProjectTree(ProjectNode *target, ProjectNode *source)
+{
+    QTC_ASSERT(target && source, return false);
+    if (!isSameNode(target, source))
+        return false;
+
+    QList<FolderNode *> changedFolders;
+    QList<FolderNode *> extendedFolders;
+    // Kept until the project tree knows that they are gone
+    auto removedNodes = std::make_shared<std::vector<std::unique_ptr<Node>>>();
+    mergeFolderNode(target, source, changedFolders, extendedFolders, *removedNodes);
+    if (changedFolders.isEmpty())
+        return true;
+
+    // Like a new root node gets it from the project
+    for (FolderNode *folder : std::as_const(extendedFolders))
+        ProjectTree::applyTreeManager(folder, ProjectTree::SyncPhase);
+
+    // One notification for all changes, the project updates its file list for each
+    FolderNode *changed = changedFolders.first();
+    for (FolderNode *folder : std::as_const(changedFolders))
+        changed = commonAncestor(changed, folder);
+    QTC_ASSERT(changed, changed = target);
+    changed->handleSubTreeChanged(changed);
+
+    // The project tree updates its current node after the notification, in the event loop
+    if (!removedNodes->empty()) {
+        QMetaObject::invokeMethod(
+            ProjectTree::instance(), [removedNodes] { removedNodes->clear(); }, Qt::QueuedConnection);
+    }
+    return true;
+}
+
 } // CMakeProjectManager::Internal
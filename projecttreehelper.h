@@ -39,15 +39,32 @@ void addCMakePresets(ProjectExplorer::FolderNode *root, const Utils::FilePath &s
 QHash<Utils::FilePath, ProjectExplorer::ProjectNode *> addCMakeLists(
     CMakeProjectNode *root, std::vector<std::unique_ptr<ProjectExplorer::FileNode>> &&cmakeLists);
 
+// The project and target nodes created while building a tree, so that they are found
+// without searching the children of the CMakeLists.txt nodes.
+class TreeNodeIndex
+{
+public:
+    QHash<Utils::FilePath, ProjectExplorer::ProjectNode *> projectNodes;
+    QHash<std::pair<Utils::FilePath, QString>, CMakeTargetNode *> targetNodes; // Directory, build key
+};
+
 void createProjectNode(const QHash<Utils::FilePath, ProjectExplorer::ProjectNode *> &cmakeListsNodes,
                        const Utils::FilePath &dir,
-                       const QString &displayName);
+                       const QString &displayName,
+                       TreeNodeIndex &index);
 CMakeTargetNode *createTargetNode(
     const QHash<Utils::FilePath, ProjectExplorer::ProjectNode *> &cmakeListsNodes,
     const Utils::FilePath &dir,
-    const QString &displayName);
+    const QString &displayName,
+    TreeNodeIndex &index);
 
 void addFileSystemNodes(ProjectExplorer::ProjectNode *root,
                         const std::shared_ptr<ProjectExplorer::FolderNode> &folderNode);
 
+// Moves the nodes of source that target lacks into target, and removes the nodes that source
+// lacks, so that the remaining nodes of target and the state of the views on them are kept.
+// The project tree is notified about the changed folders. Returns false without changing
+// target if the root nodes differ.
+bool mergeProjectTree(ProjectExplorer::ProjectNode *target, ProjectExplorer::ProjectNode *source);
+
 } // CMakeProjectManager::Internal